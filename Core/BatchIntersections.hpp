@@ -0,0 +1,275 @@
+#pragma once
+#include "./BatchPredicates.hpp"
+#include "./Line.hpp"
+#include "./PointCloud.hpp"
+#include "./Predicates.hpp"
+#include "./Simd_dispatch.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace GeomCPP {
+
+// Output of the batched segment intersection kernels, one entry per lane.
+// hits[i] is 1 when the segments of lane i intersect in the sense of
+// Line::intersects. t and u are the parameters of the crossing along the
+// first and second segment, (x, y) the crossing itself; lanes without a hit
+// hold zeros there.
+template <typename Real> struct segment_intersection_buffers {
+  std::span<std::uint8_t> hits;
+  std::span<Real> t, u, x, y;
+};
+
+// Batched Line::intersects over structure-of-arrays inputs that also
+// locates the crossing. The four orientations it decides on give the
+// parameters for free: along ab the signed distance to the line cd falls
+// linearly from orient(c, d, a) to orient(c, d, b), so t = o3 / (o3 - o4),
+// and likewise u = o1 / (o1 - o2). A branch-free filter pass evaluates the
+// orientations in double precision; lanes where any sign fails its error
+// bound (near-degenerate, touching or parallel pairs) are redone one by one
+// with the exact predicates.
+namespace detail {
+
+template <typename T>
+using batch_real =
+    std::conditional_t<std::is_floating_point_v<accumulate_t<T>>,
+                       accumulate_t<T>, double>;
+
+// Marks lanes the filter could not decide.
+inline constexpr std::uint8_t undecided_lane = 2;
+
+// FixedFirst: the first segment (a, b) is shared by every lane.
+template <typename T, typename Real, bool FixedFirst>
+GEOMCPP_ALWAYS_INLINE void
+segment_intersection_filter(const T *ax, const T *ay, const T *bx,
+                            const T *by, const T *cx, const T *cy,
+                            const T *dx, const T *dy, size_t count,
+                            std::uint8_t *GEOMCPP_RESTRICT hits,
+                            Real *GEOMCPP_RESTRICT t,
+                            Real *GEOMCPP_RESTRICT u,
+                            Real *GEOMCPP_RESTRICT x,
+                            Real *GEOMCPP_RESTRICT y) {
+  for (size_t i = 0; i < count; ++i) {
+    size_t j = FixedFirst ? 0 : i;
+    double ax_i = static_cast<double>(ax[j]);
+    double ay_i = static_cast<double>(ay[j]);
+    double rx = static_cast<double>(bx[j]) - ax_i;
+    double ry = static_cast<double>(by[j]) - ay_i;
+    double cx_i = static_cast<double>(cx[i]);
+    double cy_i = static_cast<double>(cy[i]);
+    double dx_i = static_cast<double>(dx[i]);
+    double dy_i = static_cast<double>(dy[i]);
+    double sx = dx_i - cx_i, sy = dy_i - cy_i;
+
+    double l1 = rx * (cy_i - ay_i), r1 = ry * (cx_i - ax_i);
+    double l2 = rx * (dy_i - ay_i), r2 = ry * (dx_i - ax_i);
+    double l3 = sx * (ay_i - cy_i), r3 = sy * (ax_i - cx_i);
+    double l4 = sx * (static_cast<double>(by[j]) - cy_i),
+           r4 = sy * (static_cast<double>(bx[j]) - cx_i);
+    double l5 = rx * sy, r5 = ry * sx;
+    double o1 = l1 - r1, o2 = l2 - r2, o3 = l3 - r3, o4 = l4 - r4;
+    double turn = l5 - r5;
+
+    bool decided =
+        (constexpr_abs(o1) >
+         cross_error_bound * (constexpr_abs(l1) + constexpr_abs(r1))) &
+        (constexpr_abs(o2) >
+         cross_error_bound * (constexpr_abs(l2) + constexpr_abs(r2))) &
+        (constexpr_abs(o3) >
+         cross_error_bound * (constexpr_abs(l3) + constexpr_abs(r3))) &
+        (constexpr_abs(o4) >
+         cross_error_bound * (constexpr_abs(l4) + constexpr_abs(r4))) &
+        (constexpr_abs(turn) >
+         cross_error_bound * (constexpr_abs(l5) + constexpr_abs(r5)));
+    bool hit = ((o1 > 0) != (o2 > 0)) & ((o3 > 0) != (o4 > 0));
+    bool found = decided & hit;
+
+    // Every lane divides and is then masked: a select on the operands would
+    // be sunk into a branch (the arithmetic may trap), which stops the
+    // vectorizer. Lanes without a hit end up as +0.
+    double along = o3 / (o3 - o4), across = o1 / (o1 - o2);
+    double px = ax_i + along * rx, py = ay_i + along * ry;
+    std::uint64_t keep = std::uint64_t{0} - static_cast<std::uint64_t>(found);
+    auto masked = [keep](double value) {
+      return std::bit_cast<double>(std::bit_cast<std::uint64_t>(value) & keep);
+    };
+    hits[i] = decided ? static_cast<std::uint8_t>(hit) : undecided_lane;
+    t[i] = static_cast<Real>(masked(along));
+    u[i] = static_cast<Real>(masked(across));
+    x[i] = static_cast<Real>(masked(px));
+    y[i] = static_cast<Real>(masked(py));
+  }
+}
+
+template <typename T, typename Real, bool FixedFirst>
+using segment_intersection_fn =
+    void (*)(const T *, const T *, const T *, const T *, const T *,
+             const T *, const T *, const T *, size_t, std::uint8_t *, Real *,
+             Real *, Real *, Real *);
+
+template <typename T, typename Real, bool FixedFirst>
+void segment_intersection_generic(const T *ax, const T *ay, const T *bx,
+                                  const T *by, const T *cx, const T *cy,
+                                  const T *dx, const T *dy, size_t count,
+                                  std::uint8_t *hits, Real *t, Real *u,
+                                  Real *x, Real *y) {
+  segment_intersection_filter<T, Real, FixedFirst>(
+      ax, ay, bx, by, cx, cy, dx, dy, count, hits, t, u, x, y);
+}
+
+#if GEOMCPP_SIMD_X86
+template <typename T, typename Real, bool FixedFirst>
+__attribute__((target("avx2"))) void
+segment_intersection_avx2(const T *ax, const T *ay, const T *bx,
+                          const T *by, const T *cx, const T *cy,
+                          const T *dx, const T *dy, size_t count,
+                          std::uint8_t *hits, Real *t, Real *u, Real *x,
+                          Real *y) {
+  segment_intersection_filter<T, Real, FixedFirst>(
+      ax, ay, bx, by, cx, cy, dx, dy, count, hits, t, u, x, y);
+}
+
+template <typename T, typename Real, bool FixedFirst>
+__attribute__((target("avx512f"))) void
+segment_intersection_avx512(const T *ax, const T *ay, const T *bx,
+                            const T *by, const T *cx, const T *cy,
+                            const T *dx, const T *dy, size_t count,
+                            std::uint8_t *hits, Real *t, Real *u, Real *x,
+                            Real *y) {
+  segment_intersection_filter<T, Real, FixedFirst>(
+      ax, ay, bx, by, cx, cy, dx, dy, count, hits, t, u, x, y);
+}
+#endif // GEOMCPP_SIMD_X86
+
+template <typename T, typename Real, bool FixedFirst>
+segment_intersection_fn<T, Real, FixedFirst>
+active_segment_intersection() {
+  static const segment_intersection_fn<T, Real, FixedFirst> kernel = [] {
+#if GEOMCPP_SIMD_X86
+    switch (active_simd_kernels().level) {
+    case simd_level::avx512:
+      return &segment_intersection_avx512<T, Real, FixedFirst>;
+    case simd_level::avx2:
+      return &segment_intersection_avx2<T, Real, FixedFirst>;
+    default:
+      break;
+    }
+#endif
+    return &segment_intersection_generic<T, Real, FixedFirst>;
+  }();
+  return kernel;
+}
+
+// One lane with the exact predicates Line::intersects uses. The decision is
+// exact; the orientations' magnitudes only place the crossing.
+template <typename T, typename Real>
+void segment_intersection_exact(T ax, T ay, T bx, T by, T cx, T cy, T dx,
+                                T dy, std::uint8_t &hit, Real &t, Real &u,
+                                Real &x, Real &y) {
+  int o1 = orientation_sign(ax, ay, bx, by, cx, cy);
+  int o2 = orientation_sign(ax, ay, bx, by, dx, dy);
+  int o3 = orientation_sign(cx, cy, dx, dy, ax, ay);
+  int o4 = orientation_sign(cx, cy, dx, dy, bx, by);
+  bool parallel = cross_sign(ax, ay, bx, by, cx, cy, dx, dy) == 0;
+  hit = !parallel && o1 * o2 <= 0 && o3 * o4 <= 0;
+  t = u = x = y = 0;
+  if (!hit)
+    return;
+
+  auto orient = [](T px, T py, T qx, T qy, T rx, T ry) {
+    return orient2d(static_cast<double>(px), static_cast<double>(py),
+                    static_cast<double>(qx), static_cast<double>(qy),
+                    static_cast<double>(rx), static_cast<double>(ry));
+  };
+  auto fraction = [](double from, double to) {
+    return from == to ? 0.0 : std::clamp(from / (from - to), 0.0, 1.0);
+  };
+  double along = fraction(orient(cx, cy, dx, dy, ax, ay),
+                          orient(cx, cy, dx, dy, bx, by));
+  double across = fraction(orient(ax, ay, bx, by, cx, cy),
+                           orient(ax, ay, bx, by, dx, dy));
+  double ax_d = static_cast<double>(ax), ay_d = static_cast<double>(ay);
+  t = static_cast<Real>(along);
+  u = static_cast<Real>(across);
+  x = static_cast<Real>(ax_d + along * (static_cast<double>(bx) - ax_d));
+  y = static_cast<Real>(ay_d + along * (static_cast<double>(by) - ay_d));
+}
+
+template <typename T, typename Real, bool FixedFirst>
+void segment_intersections(const T *ax, const T *ay, const T *bx,
+                           const T *by, const T *cx, const T *cy,
+                           const T *dx, const T *dy, size_t count,
+                           segment_intersection_buffers<Real> &out) {
+  auto exact = [&](size_t i) {
+    size_t j = FixedFirst ? 0 : i;
+    segment_intersection_exact(ax[j], ay[j], bx[j], by[j], cx[i], cy[i],
+                               dx[i], dy[i], out.hits[i], out.t[i],
+                               out.u[i], out.x[i], out.y[i]);
+  };
+
+  if constexpr (simd_element<T>) {
+    active_segment_intersection<T, Real, FixedFirst>()(
+        ax, ay, bx, by, cx, cy, dx, dy, count, out.hits.data(),
+        out.t.data(), out.u.data(), out.x.data(), out.y.data());
+    for (size_t i = 0; i < count; ++i)
+      if (out.hits[i] == undecided_lane)
+        exact(i);
+  } else {
+    for (size_t i = 0; i < count; ++i)
+      exact(i);
+  }
+}
+
+template <typename Real>
+void check_output_size(size_t count,
+                       const segment_intersection_buffers<Real> &out) {
+  check_batch_size(count, out.hits.size());
+  check_batch_size(count, out.t.size());
+  check_batch_size(count, out.u.size());
+  check_batch_size(count, out.x.size());
+  check_batch_size(count, out.y.size());
+}
+
+} // namespace detail
+
+// Lane i tests segment against (starts[i], ends[i]); t runs along segment.
+template <typename T>
+  requires point_numeric<T>
+void intersect_segments(
+    const Line<T, 2> &segment, const PointCloud<T, 2> &starts,
+    const PointCloud<T, 2> &ends,
+    segment_intersection_buffers<detail::batch_real<T>> out) {
+  detail::check_batch_size(starts.size(), ends.size());
+  detail::check_output_size(starts.size(), out);
+  auto a = segment.get_start(), b = segment.get_end();
+  T ax = a[0], ay = a[1], bx = b[0], by = b[1];
+  detail::segment_intersections<T, detail::batch_real<T>, true>(
+      &ax, &ay, &bx, &by, starts.axis_data(0), starts.axis_data(1),
+      ends.axis_data(0), ends.axis_data(1), starts.size(), out);
+}
+
+// Lane i tests (first_starts[i], first_ends[i]) against (second_starts[i],
+// second_ends[i]).
+template <typename T>
+  requires point_numeric<T>
+void intersect_segments(
+    const PointCloud<T, 2> &first_starts, const PointCloud<T, 2> &first_ends,
+    const PointCloud<T, 2> &second_starts,
+    const PointCloud<T, 2> &second_ends,
+    segment_intersection_buffers<detail::batch_real<T>> out) {
+  size_t count = first_starts.size();
+  detail::check_batch_size(count, first_ends.size());
+  detail::check_batch_size(count, second_starts.size());
+  detail::check_batch_size(count, second_ends.size());
+  detail::check_output_size(count, out);
+  detail::segment_intersections<T, detail::batch_real<T>, false>(
+      first_starts.axis_data(0), first_starts.axis_data(1),
+      first_ends.axis_data(0), first_ends.axis_data(1),
+      second_starts.axis_data(0), second_starts.axis_data(1),
+      second_ends.axis_data(0), second_ends.axis_data(1), count, out);
+}
+
+} // namespace GeomCPP
@@ -0,0 +1,175 @@
+#pragma once
+#include "./PointCloud.hpp"
+#include "./Predicates.hpp"
+#include "./Simd_dispatch.hpp"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace GeomCPP {
+
+// Batched orient2d over structure-of-arrays inputs. A branch-free filter pass
+// evaluates every determinant in double precision and keeps the signs that
+// clear the forward error bound; lanes left at zero (ambiguous or exactly
+// collinear) are then re-evaluated one by one with the adaptive orient2d.
+namespace detail {
+
+// FixedSegment: a and b are single values shared by every lane.
+template <typename T, bool FixedSegment>
+GEOMCPP_ALWAYS_INLINE void
+orientation_filter(const T *ax, const T *ay, const T *bx, const T *by,
+                   const T *cx, const T *cy, size_t count,
+                   std::int8_t *signs) {
+  for (size_t i = 0; i < count; ++i) {
+    size_t j = FixedSegment ? 0 : i;
+    double ax_i = static_cast<double>(ax[j]);
+    double ay_i = static_cast<double>(ay[j]);
+    double left = (static_cast<double>(bx[j]) - ax_i) *
+                  (static_cast<double>(cy[i]) - ay_i);
+    double right = (static_cast<double>(by[j]) - ay_i) *
+                   (static_cast<double>(cx[i]) - ax_i);
+    double determinant = left - right;
+    double bound = cross_error_bound * (constexpr_abs(left) +
+                                        constexpr_abs(right));
+    signs[i] = static_cast<std::int8_t>((determinant > bound) -
+                                        (determinant < -bound));
+  }
+}
+
+template <typename T, bool FixedSegment>
+using orientation_filter_fn = void (*)(const T *, const T *, const T *,
+                                       const T *, const T *, const T *,
+                                       size_t, std::int8_t *);
+
+template <typename T, bool FixedSegment>
+void orientation_filter_generic(const T *ax, const T *ay, const T *bx,
+                                const T *by, const T *cx, const T *cy,
+                                size_t count, std::int8_t *signs) {
+  orientation_filter<T, FixedSegment>(ax, ay, bx, by, cx, cy, count, signs);
+}
+
+#if GEOMCPP_SIMD_X86
+// Contracting left - right into an FMA only shrinks the rounding error, so
+// the bound stays valid whichever instructions the compiler picks.
+template <typename T, bool FixedSegment>
+__attribute__((target("avx2"))) void
+orientation_filter_avx2(const T *ax, const T *ay, const T *bx, const T *by,
+                        const T *cx, const T *cy, size_t count,
+                        std::int8_t *signs) {
+  orientation_filter<T, FixedSegment>(ax, ay, bx, by, cx, cy, count, signs);
+}
+
+template <typename T, bool FixedSegment>
+__attribute__((target("avx512f"))) void
+orientation_filter_avx512(const T *ax, const T *ay, const T *bx,
+                          const T *by, const T *cx, const T *cy,
+                          size_t count, std::int8_t *signs) {
+  orientation_filter<T, FixedSegment>(ax, ay, bx, by, cx, cy, count, signs);
+}
+#endif // GEOMCPP_SIMD_X86
+
+template <typename T, bool FixedSegment>
+orientation_filter_fn<T, FixedSegment> active_orientation_filter() {
+  static const orientation_filter_fn<T, FixedSegment> kernel = [] {
+#if GEOMCPP_SIMD_X86
+    switch (active_simd_kernels().level) {
+    case simd_level::avx512:
+      return &orientation_filter_avx512<T, FixedSegment>;
+    case simd_level::avx2:
+      return &orientation_filter_avx2<T, FixedSegment>;
+    default:
+      break;
+    }
+#endif
+    return &orientation_filter_generic<T, FixedSegment>;
+  }();
+  return kernel;
+}
+
+template <typename T, bool FixedSegment>
+void orientation_signs(const T *ax, const T *ay, const T *bx, const T *by,
+                       const T *cx, const T *cy, size_t count,
+                       std::int8_t *signs) {
+  auto exact = [&](size_t i) {
+    size_t j = FixedSegment ? 0 : i;
+    return static_cast<std::int8_t>(
+        orientation_sign(ax[j], ay[j], bx[j], by[j], cx[i], cy[i]));
+  };
+
+  if constexpr (simd_element<T>) {
+    active_orientation_filter<T, FixedSegment>()(ax, ay, bx, by, cx, cy,
+                                                 count, signs);
+    for (size_t i = 0; i < count; ++i)
+      if (signs[i] == 0)
+        signs[i] = exact(i);
+  } else {
+    // Integers take the exact integer path; 16-bit storage types are rare
+    // enough here that widening lane by lane is fine.
+    for (size_t i = 0; i < count; ++i)
+      signs[i] = exact(i);
+  }
+}
+
+inline void check_batch_size(size_t expected, size_t actual) {
+  if (expected != actual)
+    throw std::invalid_argument("Batch inputs must have the same size.");
+}
+
+} // namespace detail
+
+// signs[i] = sign of orient2d(a, b, (xs[i], ys[i])): +1 if the point lies to
+// the left of the directed segment ab, -1 to the right, 0 on its line.
+template <typename T>
+  requires point_numeric<T>
+void orientation_signs(const Point<T, 2> &a, const Point<T, 2> &b,
+                       std::span<const T> xs, std::span<const T> ys,
+                       std::span<std::int8_t> signs) {
+  detail::check_batch_size(xs.size(), ys.size());
+  detail::check_batch_size(xs.size(), signs.size());
+  T ax = a[0], ay = a[1], bx = b[0], by = b[1];
+  detail::orientation_signs<T, true>(&ax, &ay, &bx, &by, xs.data(),
+                                     ys.data(), xs.size(), signs.data());
+}
+
+template <typename T>
+  requires point_numeric<T>
+void orientation_signs(const Point<T, 2> &a, const Point<T, 2> &b,
+                       const PointCloud<T, 2> &points,
+                       std::span<std::int8_t> signs) {
+  orientation_signs(
+      a, b, std::span<const T>(points.axis_data(0), points.size()),
+      std::span<const T>(points.axis_data(1), points.size()), signs);
+}
+
+// signs[i] = sign of orient2d(a[i], b[i], c[i]) for independent triplets.
+template <typename T>
+  requires point_numeric<T>
+void orientation_signs(const PointCloud<T, 2> &a, const PointCloud<T, 2> &b,
+                       const PointCloud<T, 2> &c,
+                       std::span<std::int8_t> signs) {
+  detail::check_batch_size(a.size(), b.size());
+  detail::check_batch_size(a.size(), c.size());
+  detail::check_batch_size(a.size(), signs.size());
+  detail::orientation_signs<T, false>(
+      a.axis_data(0), a.axis_data(1), b.axis_data(0), b.axis_data(1),
+      c.axis_data(0), c.axis_data(1), a.size(), signs.data());
+}
+
+// Batched counterpart of Point::collinear against the line through a and b.
+template <typename T>
+  requires point_numeric<T>
+std::vector<bool> collinear(const Point<T, 2> &a, const Point<T, 2> &b,
+                            const PointCloud<T, 2> &points) {
+  std::vector<std::int8_t> signs(points.size());
+  orientation_signs(a, b, points, std::span<std::int8_t>(signs));
+  std::vector<bool> flags(signs.size());
+  for (size_t i = 0; i < signs.size(); ++i)
+    flags[i] = signs[i] == 0;
+  return flags;
+}
+
+} // namespace GeomCPP
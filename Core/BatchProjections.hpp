@@ -0,0 +1,152 @@
+#pragma once
+#include "./BatchPredicates.hpp"
+#include "./PointCloud.hpp"
+#include "./PreparedLine.hpp"
+#include "./Simd_dispatch.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace GeomCPP {
+
+// Output of classify_points, one entry per point. on[i] is 1 when point i
+// lies on the segment, t[i] is the parameter of its projection onto the
+// carrying line (0 at start, 1 at end, unclamped) and distance[i] its signed
+// perpendicular distance to that line, positive to the left of start -> end.
+template <typename Real> struct point_segment_buffers {
+  std::span<std::uint8_t> on;
+  std::span<Real> t, distance;
+};
+
+// Batched point-on-segment classification against one fixed segment. With
+// r = p - start and the cached direction d, the dot product d . r scaled by
+// 1 / |d|^2 gives t and the cross product d x r scaled by 1 / |d| gives the
+// distance, so each point costs two products per axis and no division.
+namespace detail {
+
+template <typename T, typename Real>
+GEOMCPP_ALWAYS_INLINE void
+point_segment_loop(const T *xs, const T *ys, size_t count, Real ax, Real ay,
+                   Real dx, Real dy, Real inverse_length,
+                   Real inverse_squared_length, Real max_distance,
+                   Real min_t, Real max_t, std::uint8_t *GEOMCPP_RESTRICT on,
+                   Real *GEOMCPP_RESTRICT t, Real *GEOMCPP_RESTRICT distance) {
+  for (size_t i = 0; i < count; ++i) {
+    Real rx = static_cast<Real>(xs[i]) - ax;
+    Real ry = static_cast<Real>(ys[i]) - ay;
+    Real along = (dx * rx + dy * ry) * inverse_squared_length;
+    Real across = (dx * ry - dy * rx) * inverse_length;
+    on[i] = (along >= min_t) & (along <= max_t) &
+            (constexpr_abs(across) <= max_distance);
+    t[i] = along;
+    distance[i] = across;
+  }
+}
+
+template <typename T, typename Real>
+using point_segment_fn = void (*)(const T *, const T *, size_t, Real, Real,
+                                  Real, Real, Real, Real, Real, Real, Real,
+                                  std::uint8_t *, Real *, Real *);
+
+template <typename T, typename Real>
+void point_segment_generic(const T *xs, const T *ys, size_t count, Real ax,
+                           Real ay, Real dx, Real dy, Real inverse_length,
+                           Real inverse_squared_length, Real max_distance,
+                           Real min_t, Real max_t, std::uint8_t *on, Real *t,
+                           Real *distance) {
+  point_segment_loop(xs, ys, count, ax, ay, dx, dy, inverse_length,
+                     inverse_squared_length, max_distance, min_t, max_t, on,
+                     t, distance);
+}
+
+#if GEOMCPP_SIMD_X86
+template <typename T, typename Real>
+__attribute__((target("avx2,fma"))) void
+point_segment_avx2(const T *xs, const T *ys, size_t count, Real ax, Real ay,
+                   Real dx, Real dy, Real inverse_length,
+                   Real inverse_squared_length, Real max_distance,
+                   Real min_t, Real max_t, std::uint8_t *on, Real *t,
+                   Real *distance) {
+  point_segment_loop(xs, ys, count, ax, ay, dx, dy, inverse_length,
+                     inverse_squared_length, max_distance, min_t, max_t, on,
+                     t, distance);
+}
+
+template <typename T, typename Real>
+__attribute__((target("avx512f"))) void
+point_segment_avx512(const T *xs, const T *ys, size_t count, Real ax,
+                     Real ay, Real dx, Real dy, Real inverse_length,
+                     Real inverse_squared_length, Real max_distance,
+                     Real min_t, Real max_t, std::uint8_t *on, Real *t,
+                     Real *distance) {
+  point_segment_loop(xs, ys, count, ax, ay, dx, dy, inverse_length,
+                     inverse_squared_length, max_distance, min_t, max_t, on,
+                     t, distance);
+}
+#endif // GEOMCPP_SIMD_X86
+
+template <typename T, typename Real>
+point_segment_fn<T, Real> active_point_segment() {
+  static const point_segment_fn<T, Real> kernel = [] {
+#if GEOMCPP_SIMD_X86
+    switch (active_simd_kernels().level) {
+    case simd_level::avx512:
+      return &point_segment_avx512<T, Real>;
+    case simd_level::avx2:
+      return &point_segment_avx2<T, Real>;
+    default:
+      break;
+    }
+#endif
+    return &point_segment_generic<T, Real>;
+  }();
+  return kernel;
+}
+
+} // namespace detail
+
+// Classifies every point against segment. A point is on it when its
+// projection falls within the segment and it lies at most max_distance from
+// the carrying line; a negative max_distance selects the relative tolerance
+// of PreparedLine::contains, tolerance * length. Computed in floating point,
+// so integer coordinates are not classified exactly.
+template <typename T>
+  requires point_numeric<T>
+void classify_points(
+    const PreparedLine<T, 2> &segment, const PointCloud<T, 2> &points,
+    point_segment_buffers<typename PreparedLine<T, 2>::real> out,
+    typename PreparedLine<T, 2>::real max_distance = -1) {
+  using real = typename PreparedLine<T, 2>::real;
+  size_t count = points.size();
+  detail::check_batch_size(count, out.on.size());
+  detail::check_batch_size(count, out.t.size());
+  detail::check_batch_size(count, out.distance.size());
+
+  constexpr real tolerance = PreparedLine<T, 2>::tolerance;
+  if (max_distance < 0)
+    max_distance = tolerance * segment.length();
+  auto start = segment.get_start();
+  auto direction = segment.get_direction();
+  real inverse_length = segment.get_inverse_length();
+  detail::point_segment_fn<T, real> kernel;
+  if constexpr (simd_element<T>)
+    kernel = detail::active_point_segment<T, real>();
+  else
+    kernel = &detail::point_segment_generic<T, real>;
+  kernel(points.axis_data(0), points.axis_data(1), count,
+         static_cast<real>(start[0]), static_cast<real>(start[1]),
+         direction[0], direction[1], inverse_length,
+         inverse_length * inverse_length, max_distance, -tolerance,
+         1 + tolerance, out.on.data(), out.t.data(), out.distance.data());
+}
+
+template <typename T>
+  requires point_numeric<T>
+void classify_points(
+    const Line<T, 2> &segment, const PointCloud<T, 2> &points,
+    point_segment_buffers<typename PreparedLine<T, 2>::real> out,
+    typename PreparedLine<T, 2>::real max_distance = -1) {
+  classify_points(PreparedLine<T, 2>(segment), points, out, max_distance);
+}
+
+} // namespace GeomCPP
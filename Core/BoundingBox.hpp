@@ -0,0 +1,122 @@
+#pragma once
+#include "./Line.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace GeomCPP {
+
+// Closed axis-aligned box [lower, upper]. Coordinates keep the point type so
+// containment and overlap tests are exact; measures and distances are
+// computed in floating point.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+struct BoundingBox {
+  using point = Point<T, Dim>;
+  using real = std::conditional_t<std::is_floating_point_v<accumulate_t<T>>,
+                                  accumulate_t<T>, double>;
+
+  std::array<T, Dim> lower;
+  std::array<T, Dim> upper;
+
+  // Smallest box holding both points, given in any order.
+  static constexpr BoundingBox of(const point &a, const point &b) {
+    BoundingBox box;
+    for (size_t d = 0; d < Dim; ++d) {
+      box.lower[d] = std::min(a[d], b[d]);
+      box.upper[d] = std::max(a[d], b[d]);
+    }
+    return box;
+  }
+
+  static constexpr BoundingBox of(const Line<T, Dim> &line) {
+    return of(line.get_start(), line.get_end());
+  }
+
+  constexpr void expand(const BoundingBox &other) {
+    for (size_t d = 0; d < Dim; ++d) {
+      lower[d] = std::min(lower[d], other.lower[d]);
+      upper[d] = std::max(upper[d], other.upper[d]);
+    }
+  }
+
+  constexpr BoundingBox merged(const BoundingBox &other) const {
+    BoundingBox box = *this;
+    box.expand(other);
+    return box;
+  }
+
+  constexpr bool overlaps(const BoundingBox &other) const {
+    for (size_t d = 0; d < Dim; ++d)
+      if (other.upper[d] < lower[d] || upper[d] < other.lower[d])
+        return false;
+    return true;
+  }
+
+  constexpr bool contains(const point &p) const {
+    for (size_t d = 0; d < Dim; ++d)
+      if (p[d] < lower[d] || upper[d] < p[d])
+        return false;
+    return true;
+  }
+
+  constexpr bool contains(const BoundingBox &other) const {
+    for (size_t d = 0; d < Dim; ++d)
+      if (other.lower[d] < lower[d] || upper[d] < other.upper[d])
+        return false;
+    return true;
+  }
+
+  // Exact: the closed segment and the closed box share at least one point.
+  constexpr bool intersects(const Line<T, Dim> &line) const
+    requires(Dim == 2)
+  {
+    if (!overlaps(of(line)))
+      return false;
+
+    // The bounding boxes overlap, so the only separating axis left is the
+    // segment's normal: all four corners strictly on one side.
+    const point a = line.get_start(), b = line.get_end();
+    const std::array<std::array<T, 2>, 4> corners = {{{lower[0], lower[1]},
+                                                      {upper[0], lower[1]},
+                                                      {upper[0], upper[1]},
+                                                      {lower[0], upper[1]}}};
+    int positive = 0, negative = 0;
+    for (const auto &corner : corners) {
+      int side = orientation_sign(a[0], a[1], b[0], b[1], corner[0],
+                                  corner[1]);
+      positive += side > 0;
+      negative += side < 0;
+    }
+    return positive < 4 && negative < 4;
+  }
+
+  constexpr real center(size_t dimension) const {
+    return (static_cast<real>(lower[dimension]) +
+            static_cast<real>(upper[dimension])) /
+           2;
+  }
+
+  // Area in 2D, volume in 3D.
+  constexpr real measure() const {
+    real result = 1;
+    for (size_t d = 0; d < Dim; ++d)
+      result *= static_cast<real>(upper[d]) - static_cast<real>(lower[d]);
+    return result;
+  }
+
+  // Zero for points inside the box.
+  constexpr real squared_distance(const point &p) const {
+    real sum = 0;
+    for (size_t d = 0; d < Dim; ++d) {
+      real value = static_cast<real>(p[d]);
+      real gap = std::max({static_cast<real>(lower[d]) - value, real{0},
+                           value - static_cast<real>(upper[d])});
+      sum += gap * gap;
+    }
+    return sum;
+  }
+};
+
+} // namespace GeomCPP
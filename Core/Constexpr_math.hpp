@@ -0,0 +1,96 @@
+#pragma once
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace GeomCPP {
+
+// abs/sqrt usable in constant expressions. At run time they forward to the
+// <cmath> implementations so there is no cost outside constant evaluation.
+template <typename T> constexpr T constexpr_abs(T value) {
+  if (std::is_constant_evaluated())
+    return value < T{0} ? -value : value;
+  if constexpr (std::is_unsigned_v<T>)
+    return value;
+  else
+    return static_cast<T>(std::abs(value));
+}
+
+namespace detail {
+
+// Exact value - root * root using Dekker's split product, so the Newton
+// result can be nudged to the correctly rounded neighbour.
+template <typename F> constexpr F sqrt_residual(F value, F root) {
+  constexpr F splitter =
+      std::is_same_v<F, float> ? F(4097) : F(134217729.0);
+  F product = root * root;
+  F big = splitter * root;
+  F high = big - (big - root);
+  F low = root - high;
+  F error = ((high * high - product) + F{2} * high * low) + low * low;
+  return (value - product) - error;
+}
+
+template <typename F> constexpr F round_sqrt(F value, F root) {
+  if constexpr (std::is_same_v<F, float> || std::is_same_v<F, double>) {
+    using bits = std::conditional_t<std::is_same_v<F, float>, std::uint32_t,
+                                    std::uint64_t>;
+    F best = root;
+    F best_residual = constexpr_abs(sqrt_residual(value, root));
+    for (int step : {-1, 1}) {
+      F candidate =
+          std::bit_cast<F>(static_cast<bits>(std::bit_cast<bits>(root) + step));
+      F residual = constexpr_abs(sqrt_residual(value, candidate));
+      if (residual < best_residual) {
+        best = candidate;
+        best_residual = residual;
+      }
+    }
+    return best;
+  } else {
+    return root;
+  }
+}
+
+// Newton-Raphson on a value pre-scaled into [0.25, 1) so the iteration count
+// does not depend on the magnitude of the input.
+template <typename F> constexpr F newton_sqrt(F value) {
+  if (value != value || value < F{0})
+    return std::numeric_limits<F>::quiet_NaN();
+  if (value == F{0} || value == std::numeric_limits<F>::infinity())
+    return value;
+
+  F scale = 1;
+  while (value >= F{1}) {
+    value /= 4;
+    scale *= 2;
+  }
+  while (value < F{0.25}) {
+    value *= 4;
+    scale /= 2;
+  }
+
+  F current = value;
+  F previous = 0;
+  F before_previous = 0;
+  while (current != previous && current != before_previous) {
+    before_previous = previous;
+    previous = current;
+    current = F{0.5} * (current + value / current);
+  }
+  return round_sqrt(value, current) * scale;
+}
+
+} // namespace detail
+
+template <typename T> constexpr auto constexpr_sqrt(T value) {
+  using result_type =
+      std::conditional_t<std::is_floating_point_v<T>, T, double>;
+  if (std::is_constant_evaluated())
+    return detail::newton_sqrt(static_cast<result_type>(value));
+  return static_cast<result_type>(std::sqrt(static_cast<result_type>(value)));
+}
+
+} // namespace GeomCPP
@@ -0,0 +1,176 @@
+#pragma once
+#include "./Parallel.hpp"
+#include "./PointCloud.hpp"
+#include "./Simd_dispatch.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace GeomCPP {
+
+enum class distance_mode { euclidean, squared };
+
+namespace detail {
+
+// Rows handed to one thread at a time, and the most columns processed per
+// tile. Narrower tiles are used for high Dim so that every axis of a column
+// tile stays resident in L1 while each row of the row tile streams over it.
+inline constexpr size_t distance_row_tile = 32;
+inline constexpr size_t distance_col_tile = 512;
+inline constexpr size_t distance_l1_budget = 16 * 1024;
+
+template <typename T, size_t Dim>
+inline constexpr size_t distance_col_width = std::clamp<size_t>(
+    distance_l1_budget / (Dim * sizeof(T) + sizeof(accumulate_t<T>)) / 16 * 16,
+    16, distance_col_tile);
+
+// One row against one column tile: cols[d] points at the tile's first value
+// of axis d. Sums are kept in the accumulation type (float for 16-bit
+// storage) and rounded to T once per entry.
+template <typename T, size_t Dim>
+GEOMCPP_ALWAYS_INLINE void
+distance_row_tile_kernel(const accumulate_t<T> *GEOMCPP_RESTRICT row,
+                         const T *const *cols, size_t width,
+                         accumulate_t<T> *GEOMCPP_RESTRICT sums,
+                         T *GEOMCPP_RESTRICT out, bool euclidean) {
+  using accumulator = accumulate_t<T>;
+  for (size_t j = 0; j < width; ++j)
+    sums[j] = 0;
+  for (size_t d = 0; d < Dim; ++d) {
+    const accumulator row_value = row[d];
+    const T *GEOMCPP_RESTRICT col_values = cols[d];
+    for (size_t j = 0; j < width; ++j) {
+      accumulator diff = row_value - static_cast<accumulator>(col_values[j]);
+      sums[j] += diff * diff;
+    }
+  }
+  if (euclidean) {
+    for (size_t j = 0; j < width; ++j)
+      sums[j] = std::sqrt(sums[j]);
+  }
+  for (size_t j = 0; j < width; ++j)
+    out[j] = static_cast<T>(sums[j]);
+}
+
+template <typename T, size_t Dim>
+using distance_row_tile_fn = void (*)(const accumulate_t<T> *,
+                                      const T *const *, size_t,
+                                      accumulate_t<T> *, T *, bool);
+
+template <typename T, size_t Dim>
+void distance_row_tile_generic(const accumulate_t<T> *row,
+                               const T *const *cols, size_t width,
+                               accumulate_t<T> *sums, T *out,
+                               bool euclidean) {
+  distance_row_tile_kernel<T, Dim>(row, cols, width, sums, out, euclidean);
+}
+
+#if GEOMCPP_SIMD_X86
+template <typename T, size_t Dim>
+__attribute__((target("avx2,fma"))) void
+distance_row_tile_avx2(const accumulate_t<T> *row, const T *const *cols,
+                       size_t width, accumulate_t<T> *sums, T *out,
+                       bool euclidean) {
+  distance_row_tile_kernel<T, Dim>(row, cols, width, sums, out, euclidean);
+}
+
+template <typename T, size_t Dim>
+__attribute__((target("avx512f"))) void
+distance_row_tile_avx512(const accumulate_t<T> *row, const T *const *cols,
+                         size_t width, accumulate_t<T> *sums, T *out,
+                         bool euclidean) {
+  distance_row_tile_kernel<T, Dim>(row, cols, width, sums, out, euclidean);
+}
+#endif // GEOMCPP_SIMD_X86
+
+template <typename T, size_t Dim>
+distance_row_tile_fn<T, Dim> active_distance_row_tile() {
+  static const distance_row_tile_fn<T, Dim> kernel = [] {
+#if GEOMCPP_SIMD_X86
+    switch (active_simd_kernels().level) {
+    case simd_level::avx512:
+      return &distance_row_tile_avx512<T, Dim>;
+    case simd_level::avx2:
+      return &distance_row_tile_avx2<T, Dim>;
+    default:
+      break;
+    }
+#endif
+    return &distance_row_tile_generic<T, Dim>;
+  }();
+  return kernel;
+}
+
+template <typename T, size_t Dim>
+void distance_matrix_rows(const PointCloud<T, Dim> &rows,
+                          const PointCloud<T, Dim> &cols, T *out,
+                          distance_mode mode, size_t row_begin,
+                          size_t row_end) {
+  using accumulator = accumulate_t<T>;
+  constexpr size_t tile_width = distance_col_width<T, Dim>;
+  const size_t col_count = cols.size();
+  const bool euclidean = mode == distance_mode::euclidean;
+
+  // Integer and 16-bit storage types gain nothing from the ISA clones.
+  distance_row_tile_fn<T, Dim> kernel;
+  if constexpr (simd_element<T>)
+    kernel = active_distance_row_tile<T, Dim>();
+  else
+    kernel = &distance_row_tile_generic<T, Dim>;
+
+  std::array<accumulator, tile_width> sums;
+  std::array<accumulator, Dim> row;
+  std::array<const T *, Dim> col_axes;
+  for (size_t col_begin = 0; col_begin < col_count; col_begin += tile_width) {
+    const size_t width = std::min(tile_width, col_count - col_begin);
+    for (size_t d = 0; d < Dim; ++d)
+      col_axes[d] = cols.axis_data(d) + col_begin;
+
+    for (size_t i = row_begin; i < row_end; ++i) {
+      for (size_t d = 0; d < Dim; ++d)
+        row[d] = static_cast<accumulator>(rows.axis_data(d)[i]);
+      kernel(row.data(), col_axes.data(), width, sums.data(),
+             out + i * col_count + col_begin, euclidean);
+    }
+  }
+}
+
+} // namespace detail
+
+// Fills out (row-major, rows.size() x cols.size()) with the distance between
+// every point of rows and every point of cols. Row tiles are distributed over
+// threads (0 selects the hardware concurrency).
+template <typename T, size_t Dim>
+void distance_matrix(const PointCloud<T, Dim> &rows,
+                     const PointCloud<T, Dim> &cols,
+                     std::span<std::type_identity_t<T>> out,
+                     distance_mode mode = distance_mode::euclidean,
+                     size_t threads = 0) {
+  if (out.size() < rows.size() * cols.size())
+    throw std::invalid_argument(
+        "Output buffer is too small for the distance matrix.");
+
+  parallel_for(
+      0, rows.size(), detail::distance_row_tile,
+      [&](size_t row_begin, size_t row_end) {
+        detail::distance_matrix_rows(rows, cols, out.data(), mode, row_begin,
+                                     row_end);
+      },
+      threads);
+}
+
+template <typename T, size_t Dim>
+void distance_matrix(const std::vector<Point<T, Dim>> &rows,
+                     const std::vector<Point<T, Dim>> &cols,
+                     std::span<std::type_identity_t<T>> out,
+                     distance_mode mode = distance_mode::euclidean,
+                     size_t threads = 0) {
+  distance_matrix(PointCloud<T, Dim>(rows), PointCloud<T, Dim>(cols), out,
+                  mode, threads);
+}
+
+} // namespace GeomCPP
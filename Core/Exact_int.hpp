@@ -0,0 +1,76 @@
+#pragma once
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+namespace GeomCPP {
+
+#if !defined(__SIZEOF_INT128__)
+#error "GeomCPP exact integer predicates require a compiler with __int128"
+#endif
+
+__extension__ using int128_t = __int128;
+__extension__ using uint128_t = unsigned __int128;
+
+namespace detail {
+
+// Narrowest signed type holding a product of two coordinate differences
+// exactly. 64-bit coordinates overflow even 128 bits there, so their
+// products are compared in sign-magnitude form instead.
+template <std::integral T>
+using exact_product_t =
+    std::conditional_t<(sizeof(T) <= 2), std::int64_t, int128_t>;
+
+constexpr uint128_t magnitude(int128_t value) {
+  return value < 0 ? static_cast<uint128_t>(-value)
+                   : static_cast<uint128_t>(value);
+}
+
+constexpr int sign(int128_t value) { return (value > 0) - (value < 0); }
+
+// sign(a * b - c * d) for |a|, |b|, |c|, |d| < 2^64.
+constexpr int product_difference_sign(int128_t a, int128_t b, int128_t c,
+                                      int128_t d) {
+  int lhs_sign = sign(a) * sign(b);
+  int rhs_sign = sign(c) * sign(d);
+  if (lhs_sign != rhs_sign)
+    return lhs_sign > rhs_sign ? 1 : -1;
+  if (lhs_sign == 0)
+    return 0;
+
+  uint128_t lhs = magnitude(a) * magnitude(b);
+  uint128_t rhs = magnitude(c) * magnitude(d);
+  if (lhs == rhs)
+    return 0;
+  return (lhs > rhs) == (lhs_sign > 0) ? 1 : -1;
+}
+
+} // namespace detail
+
+// Exact sign of the 2D cross product (b - a) x (d - c), computed without
+// leaving integer arithmetic.
+template <std::integral T>
+constexpr int exact_cross_sign(T a0, T a1, T b0, T b1, T c0, T c1, T d0,
+                               T d1) {
+  using wide = detail::exact_product_t<T>;
+  wide u0 = static_cast<wide>(b0) - static_cast<wide>(a0);
+  wide u1 = static_cast<wide>(b1) - static_cast<wide>(a1);
+  wide v0 = static_cast<wide>(d0) - static_cast<wide>(c0);
+  wide v1 = static_cast<wide>(d1) - static_cast<wide>(c1);
+
+  if constexpr (sizeof(T) <= 4) {
+    wide cross = u0 * v1 - u1 * v0;
+    return (cross > 0) - (cross < 0);
+  } else {
+    return detail::product_difference_sign(u0, v1, u1, v0);
+  }
+}
+
+// Exact orientation of c relative to the directed line a -> b:
+// +1 counter-clockwise, -1 clockwise, 0 collinear.
+template <std::integral T>
+constexpr int exact_orientation(T a0, T a1, T b0, T b1, T c0, T c1) {
+  return exact_cross_sign(a0, a1, b0, b1, a0, a1, c0, c1);
+}
+
+} // namespace GeomCPP
@@ -0,0 +1,502 @@
+#pragma once
+#include "./Parallel.hpp"
+#include "./Point.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace GeomCPP {
+
+// Hierarchical Navigable Small World graph (Malkov and Yashunin, 2018) for
+// approximate nearest-neighbour search. Distances are squared Euclidean via
+// Point::squared_distance, which runs on the dispatched SIMD kernels for wide
+// float and double points. Insertion may run on many threads: every node's
+// adjacency lists are guarded by their own mutex and only changes to the
+// entry point take the global lock. Searches must not overlap insertion.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class HNSW {
+public:
+  using point = Point<T, Dim>;
+  using real = typename point::accumulator;
+
+  struct parameters {
+    size_t M = 16; // links per node above layer 0; layer 0 keeps 2 * M
+    size_t ef_construction = 200;
+    size_t ef_search = 64;
+    std::uint64_t seed = 42; // drives the layer assignment
+  };
+
+  struct neighbour {
+    size_t index; // insertion order
+    real squared_distance;
+  };
+
+  // Points handed to one thread at a time by the batched overloads.
+  static constexpr size_t parallel_grain = 16;
+
+private:
+  using index = std::uint32_t;
+  using scored = std::pair<real, index>;
+  static constexpr index none = std::numeric_limits<index>::max();
+  static constexpr char magic[8] = {'G', 'E', 'O', 'M', 'H', 'N', 'S', 'W'};
+  static constexpr std::uint32_t format_version = 1;
+
+  parameters params;
+  double level_scale;
+
+  std::vector<point> points;
+  std::vector<std::uint8_t> levels;
+  std::vector<std::vector<std::vector<index>>> links; // [node][layer]
+  mutable std::deque<std::mutex> node_mutexes;
+
+  std::mutex entry_mutex;
+  index entry = none;
+  int top_level = -1;
+
+  // Reusable visited marks: a node is visited when its mark equals the
+  // list's current tag, so clearing is a tag increment.
+  struct visited_list {
+    std::vector<std::uint32_t> marks;
+    std::uint32_t tag = 0;
+  };
+  mutable std::mutex pool_mutex;
+  mutable std::vector<std::unique_ptr<visited_list>> pool;
+
+  std::unique_ptr<visited_list> acquire_visited() const {
+    std::unique_ptr<visited_list> list;
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      if (!pool.empty()) {
+        list = std::move(pool.back());
+        pool.pop_back();
+      }
+    }
+    if (!list)
+      list = std::make_unique<visited_list>();
+    if (list->marks.size() < points.size())
+      list->marks.resize(points.size(), 0);
+    if (++list->tag == 0) {
+      std::fill(list->marks.begin(), list->marks.end(), 0);
+      list->tag = 1;
+    }
+    return list;
+  }
+
+  void release_visited(std::unique_ptr<visited_list> list) const {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    pool.push_back(std::move(list));
+  }
+
+  real distance(const point &query, index node) const {
+    return query.squared_distance(points[node]);
+  }
+
+  size_t max_links(int layer) const {
+    return layer == 0 ? 2 * params.M : params.M;
+  }
+
+  int random_level(size_t node) const {
+    // splitmix64 of (seed, node): independent of insertion order.
+    std::uint64_t z = params.seed + 0x9E3779B97F4A7C15ull * (node + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    double uniform = (static_cast<double>(z >> 11) + 1) * 0x1p-53;
+    return std::min(255, static_cast<int>(-std::log(uniform) * level_scale));
+  }
+
+  // Calls visit(neighbour) for each link of node on layer, holding the
+  // node's mutex when Locked.
+  template <bool Locked, typename Visit>
+  void for_each_neighbour(index node, int layer, Visit &&visit) const {
+    std::unique_lock<std::mutex> lock(node_mutexes[node], std::defer_lock);
+    if constexpr (Locked)
+      lock.lock();
+    for (index next : links[node][layer])
+      visit(next);
+  }
+
+  template <bool Locked>
+  index greedy_step(const point &query, index current, int layer) const {
+    real best = distance(query, current);
+    for (bool improved = true; improved;) {
+      improved = false;
+      index from = current;
+      for_each_neighbour<Locked>(from, layer, [&](index next) {
+        real d = distance(query, next);
+        if (d < best) {
+          best = d;
+          current = next;
+          improved = true;
+        }
+      });
+    }
+    return current;
+  }
+
+  // Best-first beam search of one layer; returns up to ef candidates sorted
+  // nearest first.
+  template <bool Locked>
+  std::vector<scored> search_layer(const point &query, index start,
+                                   size_t ef, int layer) const {
+    auto visited = acquire_visited();
+    std::priority_queue<scored, std::vector<scored>, std::greater<>> open;
+    std::priority_queue<scored> best; // max-heap of the ef closest
+
+    real d = distance(query, start);
+    open.push({d, start});
+    best.push({d, start});
+    visited->marks[start] = visited->tag;
+
+    while (!open.empty()) {
+      auto [current_distance, current] = open.top();
+      if (current_distance > best.top().first && best.size() >= ef)
+        break;
+      open.pop();
+      for_each_neighbour<Locked>(current, layer, [&](index next) {
+        if (visited->marks[next] == visited->tag)
+          return;
+        visited->marks[next] = visited->tag;
+        real next_distance = distance(query, next);
+        if (best.size() < ef || next_distance < best.top().first) {
+          open.push({next_distance, next});
+          best.push({next_distance, next});
+          if (best.size() > ef)
+            best.pop();
+        }
+      });
+    }
+    release_visited(std::move(visited));
+
+    std::vector<scored> result(best.size());
+    for (size_t i = best.size(); i-- > 0; best.pop())
+      result[i] = best.top();
+    return result;
+  }
+
+  // Neighbour selection heuristic (paper, algorithm 4): keep a candidate
+  // only if it is closer to the base than to every neighbour kept so far.
+  std::vector<index> select_neighbours(const std::vector<scored> &candidates,
+                                       size_t limit) const {
+    std::vector<index> kept;
+    for (const auto &[candidate_distance, candidate] : candidates) {
+      if (kept.size() >= limit)
+        break;
+      bool diverse = true;
+      for (index other : kept)
+        if (points[candidate].squared_distance(points[other]) <
+            candidate_distance) {
+          diverse = false;
+          break;
+        }
+      if (diverse)
+        kept.push_back(candidate);
+    }
+    return kept;
+  }
+
+  void connect(index node, index other, int layer) {
+    std::lock_guard<std::mutex> lock(node_mutexes[other]);
+    auto &list = links[other][layer];
+    if (std::find(list.begin(), list.end(), node) != list.end())
+      return;
+    list.push_back(node);
+    if (list.size() <= max_links(layer))
+      return;
+
+    std::vector<scored> candidates;
+    for (index n : list)
+      candidates.push_back({points[other].squared_distance(points[n]), n});
+    std::sort(candidates.begin(), candidates.end());
+    list = select_neighbours(candidates, max_links(layer));
+  }
+
+  void insert(index node) {
+    int level = levels[node];
+    std::unique_lock<std::mutex> entry_lock(entry_mutex);
+    index start = entry;
+    int current_top = top_level;
+    if (level <= current_top)
+      entry_lock.unlock(); // keep the lock only if this node becomes entry
+
+    if (start == none) {
+      entry = node;
+      top_level = level;
+      return;
+    }
+
+    const point &query = points[node];
+    for (int layer = current_top; layer > level; --layer)
+      start = greedy_step<true>(query, start, layer);
+
+    for (int layer = std::min(level, current_top); layer >= 0; --layer) {
+      auto candidates =
+          search_layer<true>(query, start, params.ef_construction, layer);
+      auto chosen = select_neighbours(candidates, params.M);
+      {
+        std::lock_guard<std::mutex> lock(node_mutexes[node]);
+        links[node][layer] = chosen;
+      }
+      for (index other : chosen)
+        connect(node, other, layer);
+      start = candidates.front().second;
+    }
+
+    if (level > current_top) {
+      entry = node;
+      top_level = level;
+    }
+  }
+
+  void reserve_nodes(size_t count) {
+    if (points.size() + count >= none)
+      throw std::length_error("Too many points for HNSW");
+  }
+
+  void append_node(const point &p) {
+    size_t node = points.size();
+    points.push_back(p);
+    levels.push_back(static_cast<std::uint8_t>(random_level(node)));
+    links.emplace_back(levels.back() + 1);
+    node_mutexes.emplace_back();
+  }
+
+  template <typename Value>
+  static void write(std::ofstream &out, const Value &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(Value));
+  }
+
+  template <typename Value> static Value read(std::ifstream &in) {
+    Value value;
+    in.read(reinterpret_cast<char *>(&value), sizeof(Value));
+    if (!in)
+      throw std::runtime_error("Truncated HNSW index file");
+    return value;
+  }
+
+public:
+  explicit HNSW(const parameters &settings = {}) : params(settings) {
+    if (params.M < 2)
+      throw std::invalid_argument("HNSW M must be at least 2.");
+    if (params.ef_construction == 0 || params.ef_search == 0)
+      throw std::invalid_argument("HNSW ef values must be positive.");
+    level_scale = 1 / std::log(static_cast<double>(params.M));
+  }
+
+  // Moves the graph; the source must not be in use by other threads.
+  HNSW(HNSW &&other) noexcept
+      : params(other.params), level_scale(other.level_scale),
+        points(std::move(other.points)), levels(std::move(other.levels)),
+        links(std::move(other.links)),
+        node_mutexes(std::move(other.node_mutexes)), entry(other.entry),
+        top_level(other.top_level) {
+    other.entry = none;
+    other.top_level = -1;
+  }
+
+  size_t size() const { return points.size(); }
+  bool empty() const { return points.empty(); }
+  const parameters &get_parameters() const { return params; }
+  void set_ef_search(size_t ef) {
+    if (ef == 0)
+      throw std::invalid_argument("HNSW ef values must be positive.");
+    params.ef_search = ef;
+  }
+
+  const point &get_point(size_t id) const { return points.at(id); }
+
+  // Returns the id of the new point.
+  size_t add(const point &p) {
+    reserve_nodes(1);
+    append_node(p);
+    insert(static_cast<index>(points.size() - 1));
+    return points.size() - 1;
+  }
+
+  // Multi-threaded insertion; ids follow the span order. threads == 0 uses
+  // every hardware thread.
+  void add(std::span<const point> batch, size_t threads = 0) {
+    reserve_nodes(batch.size());
+    size_t first = points.size();
+    for (const point &p : batch)
+      append_node(p);
+
+    // Seed the graph serially so the threads start from a real entry point.
+    size_t serial = std::min(batch.size(), size_t{1});
+    for (size_t i = 0; i < serial; ++i)
+      insert(static_cast<index>(first + i));
+    parallel_for(
+        first + serial, points.size(), parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t node = begin; node < end; ++node)
+            insert(static_cast<index>(node));
+        },
+        threads);
+  }
+
+  // Approximate k nearest neighbours, nearest first. ef == 0 uses the
+  // configured ef_search; it is raised to k if smaller.
+  std::vector<neighbour> search(const point &query, size_t k,
+                                size_t ef = 0) const {
+    std::vector<neighbour> result;
+    if (k == 0 || entry == none)
+      return result;
+
+    index start = entry;
+    for (int layer = top_level; layer > 0; --layer)
+      start = greedy_step<false>(query, start, layer);
+    auto candidates = search_layer<false>(
+        query, start, std::max(k, ef == 0 ? params.ef_search : ef), 0);
+
+    for (size_t i = 0; i < std::min(k, candidates.size()); ++i)
+      result.push_back({candidates[i].second, candidates[i].first});
+    return result;
+  }
+
+  std::vector<std::vector<neighbour>> search(std::span<const point> queries,
+                                             size_t k, size_t ef = 0,
+                                             size_t threads = 0) const {
+    std::vector<std::vector<neighbour>> results(queries.size());
+    parallel_for(
+        0, queries.size(), parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t q = begin; q < end; ++q)
+            results[q] = search(queries[q], k, ef);
+        },
+        threads);
+    return results;
+  }
+
+  // Exact k nearest neighbours by scanning every point; the reference for
+  // measuring recall.
+  std::vector<neighbour> brute_force_search(const point &query,
+                                            size_t k) const {
+    std::vector<neighbour> all;
+    all.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+      all.push_back({i, query.squared_distance(points[i])});
+    k = std::min(k, all.size());
+    std::partial_sort(all.begin(), all.begin() + k, all.end(),
+                      [](const neighbour &a, const neighbour &b) {
+                        return a.squared_distance < b.squared_distance;
+                      });
+    all.resize(k);
+    return all;
+  }
+
+  // Binary format: magic, version, layout sizes, parameters, entry point,
+  // raw coordinates, then each node's level and adjacency lists.
+  void save(const std::string &path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+      throw std::runtime_error("Failed to open HNSW index file: " + path);
+
+    out.write(magic, sizeof(magic));
+    write(out, format_version);
+    write(out, static_cast<std::uint64_t>(Dim));
+    write(out, static_cast<std::uint64_t>(sizeof(T)));
+    write(out, static_cast<std::uint64_t>(params.M));
+    write(out, static_cast<std::uint64_t>(params.ef_construction));
+    write(out, static_cast<std::uint64_t>(params.ef_search));
+    write(out, params.seed);
+    write(out, static_cast<std::uint64_t>(points.size()));
+    write(out, entry);
+    write(out, static_cast<std::int32_t>(top_level));
+
+    for (const point &p : points)
+      for (size_t d = 0; d < Dim; ++d)
+        write(out, p.coordinate(d));
+    for (size_t node = 0; node < points.size(); ++node) {
+      write(out, levels[node]);
+      for (const auto &list : links[node]) {
+        write(out, static_cast<std::uint32_t>(list.size()));
+        out.write(reinterpret_cast<const char *>(list.data()),
+                  static_cast<std::streamsize>(list.size() * sizeof(index)));
+      }
+    }
+    if (!out)
+      throw std::runtime_error("Failed to write HNSW index file: " + path);
+  }
+
+  static HNSW load(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+      throw std::runtime_error("Failed to open HNSW index file: " + path);
+
+    char header[sizeof(magic)];
+    in.read(header, sizeof(header));
+    if (!in || std::memcmp(header, magic, sizeof(magic)) != 0 ||
+        read<std::uint32_t>(in) != format_version)
+      throw std::runtime_error("Not a GeomCPP HNSW index file: " + path);
+    if (read<std::uint64_t>(in) != Dim || read<std::uint64_t>(in) != sizeof(T))
+      throw std::runtime_error("HNSW index file has a different point type");
+
+    parameters settings;
+    settings.M = read<std::uint64_t>(in);
+    settings.ef_construction = read<std::uint64_t>(in);
+    settings.ef_search = read<std::uint64_t>(in);
+    settings.seed = read<std::uint64_t>(in);
+    HNSW index_graph(settings);
+
+    auto count = read<std::uint64_t>(in);
+    index_graph.entry = read<index>(in);
+    index_graph.top_level = read<std::int32_t>(in);
+    if (count >= none || (count > 0 && index_graph.entry >= count))
+      throw std::runtime_error("Corrupt HNSW index file: " + path);
+
+    index_graph.points.reserve(count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+      std::array<T, Dim> coords;
+      for (size_t d = 0; d < Dim; ++d)
+        coords[d] = read<T>(in);
+      index_graph.points.emplace_back(coords);
+    }
+    for (std::uint64_t node = 0; node < count; ++node) {
+      auto level = read<std::uint8_t>(in);
+      index_graph.levels.push_back(level);
+      index_graph.node_mutexes.emplace_back();
+      auto &layers = index_graph.links.emplace_back(level + 1);
+      for (auto &list : layers) {
+        list.resize(read<std::uint32_t>(in));
+        in.read(reinterpret_cast<char *>(list.data()),
+                static_cast<std::streamsize>(list.size() * sizeof(index)));
+        if (!in)
+          throw std::runtime_error("Truncated HNSW index file");
+      }
+    }
+
+    // Searches index links[node][layer] without checks, so every neighbour
+    // must exist and reach the layer it is linked on, and the entry point
+    // must reach the top layer.
+    bool consistent = count == 0 ? index_graph.entry == none &&
+                                       index_graph.top_level == -1
+                                 : index_graph.top_level ==
+                                       index_graph.levels[index_graph.entry];
+    for (size_t node = 0; consistent && node < index_graph.size(); ++node)
+      for (size_t layer = 0; layer < index_graph.links[node].size(); ++layer)
+        for (index other : index_graph.links[node][layer])
+          if (other >= index_graph.size() ||
+              index_graph.levels[other] < layer)
+            consistent = false;
+    if (!consistent)
+      throw std::runtime_error("Corrupt HNSW index file: " + path);
+    return index_graph;
+  }
+};
+
+} // namespace GeomCPP
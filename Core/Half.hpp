@@ -0,0 +1,129 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+namespace GeomCPP {
+
+namespace detail {
+
+// IEEE 754 binary32 -> binary16 with round-to-nearest-even.
+constexpr std::uint16_t float_to_half_bits(float value) {
+  std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+  std::uint32_t sign = (bits >> 16) & 0x8000u;
+  bits &= 0x7FFFFFFFu;
+
+  if (bits >= 0x7F800000u) // Inf stays Inf, NaN stays quiet NaN
+    return static_cast<std::uint16_t>(sign | 0x7C00u |
+                                      (bits > 0x7F800000u ? 0x200u : 0u));
+  if (bits >= 0x477FF000u) // Rounds to 65520 or more
+    return static_cast<std::uint16_t>(sign | 0x7C00u);
+
+  if (bits < 0x38800000u) { // Below the smallest normal half
+    if (bits < 0x33000000u)
+      return static_cast<std::uint16_t>(sign);
+    std::uint32_t shift = 126u - (bits >> 23);
+    std::uint32_t mantissa = (bits & 0x7FFFFFu) | 0x800000u;
+    std::uint32_t result = mantissa >> shift;
+    std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+    std::uint32_t halfway = 1u << (shift - 1u);
+    if (remainder > halfway || (remainder == halfway && (result & 1u)))
+      ++result;
+    return static_cast<std::uint16_t>(sign | result);
+  }
+
+  std::uint32_t result = (bits >> 13) - (112u << 10);
+  std::uint32_t remainder = bits & 0x1FFFu;
+  if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u)))
+    ++result;
+  return static_cast<std::uint16_t>(sign | result);
+}
+
+constexpr float half_bits_to_float(std::uint16_t half) {
+  std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+  std::uint32_t exponent = (half >> 10) & 0x1Fu;
+  std::uint32_t mantissa = half & 0x3FFu;
+
+  if (exponent == 0x1Fu)
+    return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+  if (exponent == 0) {
+    if (mantissa == 0)
+      return std::bit_cast<float>(sign);
+    exponent = 113;
+    while (!(mantissa & 0x400u)) {
+      mantissa <<= 1;
+      --exponent;
+    }
+    mantissa &= 0x3FFu;
+    return std::bit_cast<float>(sign | (exponent << 23) | (mantissa << 13));
+  }
+  return std::bit_cast<float>(sign | ((exponent + 112u) << 23) |
+                              (mantissa << 13));
+}
+
+// IEEE 754 binary32 -> bfloat16 (upper half of a float), nearest-even.
+constexpr std::uint16_t float_to_bfloat16_bits(float value) {
+  std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+  if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+    return static_cast<std::uint16_t>((bits >> 16) | 0x40u);
+  bits += 0x7FFFu + ((bits >> 16) & 1u);
+  return static_cast<std::uint16_t>(bits >> 16);
+}
+
+constexpr float bfloat16_bits_to_float(std::uint16_t value) {
+  return std::bit_cast<float>(static_cast<std::uint32_t>(value) << 16);
+}
+
+// Storage-only 16-bit float. It converts implicitly to and from float, so
+// every arithmetic expression on it is evaluated in float and rounded back
+// only when stored.
+template <std::uint16_t (*Encode)(float), float (*Decode)(std::uint16_t)>
+class float16_storage {
+private:
+  std::uint16_t bits = 0;
+
+public:
+  constexpr float16_storage() = default;
+  constexpr float16_storage(float value) : bits(Encode(value)) {}
+
+  constexpr operator float() const { return Decode(bits); }
+
+  static constexpr float16_storage from_bits(std::uint16_t raw) {
+    float16_storage result;
+    result.bits = raw;
+    return result;
+  }
+  constexpr std::uint16_t to_bits() const { return bits; }
+
+  constexpr float16_storage &operator+=(float other) {
+    return *this = float(*this) + other;
+  }
+  constexpr float16_storage &operator-=(float other) {
+    return *this = float(*this) - other;
+  }
+  constexpr float16_storage &operator*=(float other) {
+    return *this = float(*this) * other;
+  }
+  constexpr float16_storage &operator/=(float other) {
+    return *this = float(*this) / other;
+  }
+};
+
+} // namespace detail
+
+using float16 = detail::float16_storage<detail::float_to_half_bits,
+                                        detail::half_bits_to_float>;
+using bfloat16 = detail::float16_storage<detail::float_to_bfloat16_bits,
+                                         detail::bfloat16_bits_to_float>;
+
+template <typename T> struct is_half_precision : std::false_type {};
+template <> struct is_half_precision<float16> : std::true_type {};
+template <> struct is_half_precision<bfloat16> : std::true_type {};
+
+// Library-provided types plus any 16-bit standard floating-point type, such
+// as std::float16_t and std::bfloat16_t where the compiler offers them.
+template <typename T>
+concept half_precision = is_half_precision<T>::value ||
+                         (std::is_floating_point_v<T> && sizeof(T) == 2);
+
+} // namespace GeomCPP
@@ -0,0 +1,296 @@
+#pragma once
+#include "./Parallel.hpp"
+#include "./PointCloud.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GeomCPP {
+
+// Static KD-tree with an implicit, pointer-free layout. The points are
+// permuted so that every node owns a contiguous range [lo, hi) whose median
+// sits at lo + (hi - lo) / 2, with the left subtree before it and the right
+// subtree after it; children of node i are 2i + 1 and 2i + 2. Only the split
+// axis of each internal node is stored. Ranges of at most leaf_size points
+// are scanned linearly. All queries compare squared distances.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class KDTree {
+public:
+  using point = Point<T, Dim>;
+  using real = std::conditional_t<std::is_floating_point_v<accumulate_t<T>>,
+                                  accumulate_t<T>, double>;
+
+  struct neighbour {
+    size_t index; // position in the input the tree was built from
+    real squared_distance;
+
+    bool operator<(const neighbour &other) const {
+      return squared_distance < other.squared_distance;
+    }
+  };
+
+  static constexpr size_t leaf_size = 16;
+  // Queries handed to one thread at a time by the batched overloads.
+  static constexpr size_t parallel_grain = 64;
+
+private:
+  PointCloud<T, Dim> nodes;        // coordinates in tree order
+  std::vector<size_t> indices;     // tree order -> input index
+  std::vector<std::uint16_t> axes; // split axis per internal node
+
+  static constexpr size_t median(size_t lo, size_t hi) {
+    return lo + (hi - lo) / 2;
+  }
+
+  template <typename Coordinate>
+  void build(size_t count, Coordinate coordinate, size_t threads) {
+    indices.resize(count);
+    std::iota(indices.begin(), indices.end(), size_t{0});
+
+    // Level by level: the ranges of one level are disjoint, so they are
+    // partitioned in parallel.
+    struct range {
+      size_t node, lo, hi;
+    };
+    std::vector<range> level;
+    if (count > leaf_size)
+      level.push_back({0, 0, count});
+
+    while (!level.empty()) {
+      axes.resize(std::max(axes.size(), level.back().node + 1));
+      parallel_for(
+          0, level.size(), 1,
+          [&](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r) {
+              auto [node, lo, hi] = level[r];
+              size_t axis = 0;
+              real widest = -1;
+              for (size_t d = 0; d < Dim; ++d) {
+                real low = std::numeric_limits<real>::max();
+                real high = std::numeric_limits<real>::lowest();
+                for (size_t i = lo; i < hi; ++i) {
+                  real value = coordinate(indices[i], d);
+                  low = std::min(low, value);
+                  high = std::max(high, value);
+                }
+                if (high - low > widest) {
+                  widest = high - low;
+                  axis = d;
+                }
+              }
+              axes[node] = static_cast<std::uint16_t>(axis);
+              std::nth_element(indices.begin() + lo,
+                               indices.begin() + median(lo, hi),
+                               indices.begin() + hi,
+                               [&](size_t a, size_t b) {
+                                 return coordinate(a, axis) <
+                                        coordinate(b, axis);
+                               });
+            }
+          },
+          threads);
+
+      std::vector<range> next;
+      for (auto [node, lo, hi] : level) {
+        size_t mid = median(lo, hi);
+        if (mid - lo > leaf_size)
+          next.push_back({2 * node + 1, lo, mid});
+        if (hi - mid - 1 > leaf_size)
+          next.push_back({2 * node + 2, mid + 1, hi});
+      }
+      level = std::move(next);
+    }
+
+    nodes.resize(count);
+    for (size_t d = 0; d < Dim; ++d) {
+      T *out = nodes.axis_data(d);
+      for (size_t i = 0; i < count; ++i)
+        out[i] = static_cast<T>(coordinate(indices[i], d));
+    }
+  }
+
+  real squared_distance_to(size_t slot, const point &query) const {
+    real sum = 0;
+    for (size_t d = 0; d < Dim; ++d) {
+      real diff = static_cast<real>(nodes.axis_data(d)[slot]) -
+                  static_cast<real>(query[d]);
+      sum += diff * diff;
+    }
+    return sum;
+  }
+
+  // visit(slot) sees every candidate point; bound() is the current squared
+  // search radius used to prune the far side of a split.
+  template <typename Visit, typename Bound>
+  void descend(size_t node, size_t lo, size_t hi, const point &query,
+               Visit &visit, Bound &bound) const {
+    if (hi - lo <= leaf_size) {
+      for (size_t slot = lo; slot < hi; ++slot)
+        visit(slot);
+      return;
+    }
+
+    size_t mid = median(lo, hi);
+    size_t axis = axes[node];
+    visit(mid);
+
+    real diff = static_cast<real>(query[axis]) -
+                static_cast<real>(nodes.axis_data(axis)[mid]);
+    if (diff < 0) {
+      descend(2 * node + 1, lo, mid, query, visit, bound);
+      if (diff * diff <= bound())
+        descend(2 * node + 2, mid + 1, hi, query, visit, bound);
+    } else {
+      descend(2 * node + 2, mid + 1, hi, query, visit, bound);
+      if (diff * diff <= bound())
+        descend(2 * node + 1, lo, mid, query, visit, bound);
+    }
+  }
+
+  void collect_box(size_t node, size_t lo, size_t hi, const point &lower,
+                   const point &upper, std::vector<size_t> &out) const {
+    auto inside = [&](size_t slot) {
+      for (size_t d = 0; d < Dim; ++d) {
+        T value = nodes.axis_data(d)[slot];
+        if (value < lower[d] || upper[d] < value)
+          return false;
+      }
+      return true;
+    };
+
+    if (hi - lo <= leaf_size) {
+      for (size_t slot = lo; slot < hi; ++slot)
+        if (inside(slot))
+          out.push_back(indices[slot]);
+      return;
+    }
+
+    size_t mid = median(lo, hi);
+    size_t axis = axes[node];
+    T split = nodes.axis_data(axis)[mid];
+    if (inside(mid))
+      out.push_back(indices[mid]);
+    if (!(split < lower[axis]))
+      collect_box(2 * node + 1, lo, mid, lower, upper, out);
+    if (!(upper[axis] < split))
+      collect_box(2 * node + 2, mid + 1, hi, lower, upper, out);
+  }
+
+public:
+  KDTree() = default;
+
+  explicit KDTree(const std::vector<point> &points, size_t threads = 1) {
+    build(
+        points.size(),
+        [&](size_t i, size_t d) {
+          return static_cast<real>(points[i].coordinate(d));
+        },
+        threads);
+  }
+
+  explicit KDTree(const PointCloud<T, Dim> &cloud, size_t threads = 1) {
+    std::array<const T *, Dim> input;
+    for (size_t d = 0; d < Dim; ++d)
+      input[d] = cloud.axis_data(d);
+    build(
+        cloud.size(),
+        [&](size_t i, size_t d) { return static_cast<real>(input[d][i]); },
+        threads);
+  }
+
+  size_t size() const { return indices.size(); }
+  bool empty() const { return indices.empty(); }
+
+  // The k closest points, nearest first.
+  std::vector<neighbour> nearest(const point &query, size_t k) const {
+    std::vector<neighbour> heap;
+    if (k == 0 || empty())
+      return heap;
+    heap.reserve(k + 1);
+
+    auto visit = [&](size_t slot) {
+      real distance = squared_distance_to(slot, query);
+      if (heap.size() < k) {
+        heap.push_back({indices[slot], distance});
+        std::push_heap(heap.begin(), heap.end());
+      } else if (distance < heap.front().squared_distance) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = {indices[slot], distance};
+        std::push_heap(heap.begin(), heap.end());
+      }
+    };
+    auto bound = [&] {
+      return heap.size() < k ? std::numeric_limits<real>::infinity()
+                             : heap.front().squared_distance;
+    };
+    descend(0, 0, size(), query, visit, bound);
+
+    std::sort_heap(heap.begin(), heap.end());
+    return heap;
+  }
+
+  // Every point with |p - query| <= radius, in no particular order.
+  std::vector<neighbour> within_radius(const point &query,
+                                       real radius) const {
+    std::vector<neighbour> result;
+    if (empty() || radius < 0)
+      return result;
+
+    real limit = radius * radius;
+    auto visit = [&](size_t slot) {
+      real distance = squared_distance_to(slot, query);
+      if (distance <= limit)
+        result.push_back({indices[slot], distance});
+    };
+    auto bound = [&] { return limit; };
+    descend(0, 0, size(), query, visit, bound);
+    return result;
+  }
+
+  // Indices of the points inside the closed box [lower, upper].
+  std::vector<size_t> in_box(const point &lower, const point &upper) const {
+    std::vector<size_t> result;
+    if (!empty())
+      collect_box(0, 0, size(), lower, upper, result);
+    return result;
+  }
+
+  // Batched queries; threads == 0 uses every hardware thread.
+  std::vector<std::vector<neighbour>> nearest(std::span<const point> queries,
+                                              size_t k,
+                                              size_t threads = 0) const {
+    std::vector<std::vector<neighbour>> results(queries.size());
+    parallel_for(
+        0, queries.size(), parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t q = begin; q < end; ++q)
+            results[q] = nearest(queries[q], k);
+        },
+        threads);
+    return results;
+  }
+
+  std::vector<std::vector<neighbour>>
+  within_radius(std::span<const point> queries, real radius,
+                size_t threads = 0) const {
+    std::vector<std::vector<neighbour>> results(queries.size());
+    parallel_for(
+        0, queries.size(), parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t q = begin; q < end; ++q)
+            results[q] = within_radius(queries[q], radius);
+        },
+        threads);
+    return results;
+  }
+};
+
+} // namespace GeomCPP
@@ -1,5 +1,6 @@
 #pragma once
 #include "./Point.hpp"
+#include <algorithm>
 #include <cmath>
 #include <concepts>
 #include <stdexcept>
@@ -19,7 +20,7 @@ private:
   point end;
 
 public:
-  Line(const point &start_point, const point &end_point)
+  constexpr Line(const point &start_point, const point &end_point)
       : start(start_point), end(end_point) {
     if (start == end) {
       throw std::invalid_argument(
@@ -27,71 +28,75 @@ public:
     }
   }
 
-  point get_start() const { return start; }
-  point get_end() const { return end; }
-
-  T length() const { return start.distance(end); }
-
-  bool contains(const point &p) const {
-    auto line_vec = end - start;
-    auto point_vec = p - start;
-
-    if (line_vec.magnitude() < 1e-9)
-      return false; // Line segment too small to check containment
-
-    // Check if the point vector is a scalar multiple of the line vector
-    for (size_t i = 0; i < Dim; ++i) {
-      if (std::abs(line_vec[i]) > 1e-9) // Avoid division by zero
-      {
-        T ratio = point_vec[i] / line_vec[i];
-        for (size_t j = 0; j < Dim; ++j) {
-          if (std::abs(line_vec[j]) > 1e-9 &&
-              std::abs(point_vec[j] / line_vec[j] - ratio) > 1e-9) {
+  constexpr point get_start() const { return start; }
+  constexpr point get_end() const { return end; }
+
+  constexpr T length() const { return start.distance(end); }
+
+  constexpr bool contains(const point &p) const {
+    if constexpr (std::integral<T>) {
+      // Exact: p is on the segment iff it is collinear with it in every
+      // coordinate plane and lies within its bounding box.
+      for (size_t i = 0; i < Dim; ++i) {
+        if (p[i] < std::min(start[i], end[i]) ||
+            p[i] > std::max(start[i], end[i]))
+          return false;
+        for (size_t j = i + 1; j < Dim; ++j) {
+          if (orientation_sign(start[i], start[j], end[i], end[j], p[i],
+                               p[j]) != 0)
             return false;
+        }
+      }
+      return true;
+    } else {
+      point line_vec = end - start;
+      point point_vec = p - start;
+
+      if (line_vec.magnitude() < 1e-9)
+        return false; // Line segment too small to check containment
+
+      // Check if the point vector is a scalar multiple of the line vector
+      for (size_t i = 0; i < Dim; ++i) {
+        if (constexpr_abs(line_vec[i]) > 1e-9) // Avoid division by zero
+        {
+          T ratio = point_vec[i] / line_vec[i];
+          for (size_t j = 0; j < Dim; ++j) {
+            if (constexpr_abs(line_vec[j]) > 1e-9 &&
+                constexpr_abs(point_vec[j] / line_vec[j] - ratio) > 1e-9) {
+              return false;
+            }
           }
+          return (ratio >= 0 && ratio <= 1);
         }
-        return (ratio >= 0 && ratio <= 1);
       }
+      return false;
     }
-    return false;
   }
 
-  bool is_parallel(const Line &other) const {
-    auto this_direction = end - start;
-    auto other_direction = other.end - other.start;
-
+  constexpr bool is_parallel(const Line &other) const {
     for (size_t i = 1; i < Dim; ++i) {
-      if (std::abs(this_direction[i] * other_direction[0] -
-                   this_direction[0] * other_direction[i]) > 1e-9)
+      if (cross_sign(start[0], start[i], end[0], end[i], other.start[0],
+                     other.start[i], other.end[0], other.end[i]) != 0)
         return false;
     }
     return true;
   }
 
-  bool intersects(const Line &other) const {
+  constexpr bool intersects(const Line &other) const {
     if (is_parallel(other))
       return false;
 
-    auto p1 = start;
-    auto p2 = end;
-    auto p3 = other.start;
-    auto p4 = other.end;
-
-    T denominator =
-        (p1[0] - p2[0]) * (p3[1] - p4[1]) - (p1[1] - p2[1]) * (p3[0] - p4[0]);
-
-    if (std::abs(denominator) < 1e-9)
-      return false;
-
-    T t = ((p1[0] - p3[0]) * (p3[1] - p4[1]) -
-           (p1[1] - p3[1]) * (p3[0] - p4[0])) /
-          denominator;
-
-    T u = -((p1[0] - p2[0]) * (p1[1] - p3[1]) -
-            (p1[1] - p2[1]) * (p1[0] - p3[0])) /
-          denominator;
-
-    return t >= 0 && t <= 1 && u >= 0 && u <= 1;
+    // Non-parallel segments cross iff each one's endpoints are not strictly
+    // on the same side of the other.
+    int o1 = orientation_sign(start[0], start[1], end[0], end[1],
+                              other.start[0], other.start[1]);
+    int o2 = orientation_sign(start[0], start[1], end[0], end[1],
+                              other.end[0], other.end[1]);
+    int o3 = orientation_sign(other.start[0], other.start[1], other.end[0],
+                              other.end[1], start[0], start[1]);
+    int o4 = orientation_sign(other.start[0], other.start[1], other.end[0],
+                              other.end[1], end[0], end[1]);
+    return o1 * o2 <= 0 && o3 * o4 <= 0;
   }
 
   void print() const {
@@ -0,0 +1,385 @@
+#pragma once
+#include "./BoundingBox.hpp"
+#include "./Parallel.hpp"
+#include "./PointCloud.hpp"
+#include "./SpaceFillingCurve.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+namespace GeomCPP {
+
+// Octree over 3D points built from Morton-sorted input. Sorting by key makes
+// every node a contiguous range of the reordered points, so a node is split
+// by binary-searching the next three key bits rather than by moving points.
+// Nodes are stored breadth first with the children of a node adjacent; each
+// keeps a tight bounding box and a representative point (the one closest to
+// the centroid of its points) for level-of-detail queries.
+template <typename T>
+  requires point_numeric<T>
+class Octree {
+public:
+  using point = Point<T, 3>;
+  using box = BoundingBox<T, 3>;
+  using real = typename box::real;
+
+  struct neighbour {
+    size_t index; // position in the input the octree was built from
+    real squared_distance;
+  };
+
+  static constexpr size_t default_bucket_size = 32;
+  // Nodes handed to one thread at a time while building.
+  static constexpr size_t parallel_grain = 64;
+
+private:
+  using index = std::uint32_t;
+  static constexpr unsigned max_depth = curve_bits<3>;
+
+  struct node {
+    box bounds;
+    index first = 0, count = 0; // range of the sorted points
+    index first_child = 0;
+    std::uint8_t child_count = 0; // zero for leaves
+    index representative = 0;     // slot of a sorted point
+
+    bool leaf() const { return child_count == 0; }
+  };
+
+  PointCloud<T, 3> points;     // Morton order
+  std::vector<index> indices;  // Morton order -> input index
+  std::vector<node> nodes;     // breadth first; nodes[0] is the root
+  size_t bucket_size = default_bucket_size;
+
+  point slot_point(index slot) const {
+    return point({points.axis_data(0)[slot], points.axis_data(1)[slot],
+                  points.axis_data(2)[slot]});
+  }
+
+  real slot_squared_distance(index slot, const point &query) const {
+    real sum = 0;
+    for (size_t d = 0; d < 3; ++d) {
+      real diff = static_cast<real>(points.axis_data(d)[slot]) -
+                  static_cast<real>(query[d]);
+      sum += diff * diff;
+    }
+    return sum;
+  }
+
+  void build(const std::vector<curve_key> &keys, size_t threads) {
+    struct range {
+      index first, count;
+    };
+    std::vector<std::array<range, 8>> splits;
+    std::vector<size_t> level_starts{0};
+    nodes.push_back({});
+    nodes[0].count = static_cast<index>(points.size());
+
+    for (unsigned depth = 0; depth < max_depth; ++depth) {
+      size_t level_begin = level_starts.back(), level_end = nodes.size();
+      splits.assign(level_end - level_begin, {});
+      parallel_for(
+          level_begin, level_end, parallel_grain,
+          [&](size_t begin, size_t end) {
+            unsigned shift = 3 * (max_depth - 1 - depth);
+            for (size_t n = begin; n < end; ++n) {
+              const node &current = nodes[n];
+              auto &children = splits[n - level_begin];
+              if (current.count <= bucket_size)
+                continue;
+              auto lo = keys.begin() + current.first;
+              auto hi = lo + current.count;
+              for (unsigned octant = 0; octant < 8; ++octant) {
+                auto next = std::partition_point(lo, hi, [&](curve_key k) {
+                  return ((k >> shift) & 7) <= octant;
+                });
+                children[octant] = {static_cast<index>(lo - keys.begin()),
+                                    static_cast<index>(next - lo)};
+                lo = next;
+              }
+            }
+          },
+          threads);
+
+      for (size_t n = level_begin; n < level_end; ++n) {
+        auto &children = splits[n - level_begin];
+        nodes[n].first_child = static_cast<index>(nodes.size());
+        for (const range &child : children) {
+          if (child.count == 0)
+            continue;
+          nodes.push_back({});
+          nodes.back().first = child.first;
+          nodes.back().count = child.count;
+          ++nodes[n].child_count;
+        }
+      }
+      if (nodes.size() == level_end)
+        break;
+      level_starts.push_back(level_end);
+    }
+    level_starts.push_back(nodes.size());
+
+    // Bounds, centroids and representatives, deepest level first.
+    std::vector<std::array<real, 3>> sums(nodes.size());
+    for (size_t level = level_starts.size() - 1; level-- > 0;) {
+      parallel_for(
+          level_starts[level], level_starts[level + 1], parallel_grain,
+          [&](size_t begin, size_t end) {
+            for (size_t n = begin; n < end; ++n)
+              summarize(n, sums);
+          },
+          threads);
+    }
+  }
+
+  void summarize(size_t n, std::vector<std::array<real, 3>> &sums) {
+    node &current = nodes[n];
+    std::array<real, 3> sum{};
+    if (current.leaf()) {
+      current.bounds = box::of(slot_point(current.first),
+                               slot_point(current.first));
+      for (index slot = current.first; slot < current.first + current.count;
+           ++slot) {
+        point p = slot_point(slot);
+        current.bounds.expand(box::of(p, p));
+        for (size_t d = 0; d < 3; ++d)
+          sum[d] += static_cast<real>(p[d]);
+      }
+    } else {
+      current.bounds = nodes[current.first_child].bounds;
+      for (index c = 0; c < current.child_count; ++c) {
+        current.bounds.expand(nodes[current.first_child + c].bounds);
+        for (size_t d = 0; d < 3; ++d)
+          sum[d] += sums[current.first_child + c][d];
+      }
+    }
+    sums[n] = sum;
+
+    point centroid({static_cast<T>(sum[0] / current.count),
+                    static_cast<T>(sum[1] / current.count),
+                    static_cast<T>(sum[2] / current.count)});
+    real best = std::numeric_limits<real>::infinity();
+    auto consider = [&](index slot) {
+      real distance = slot_squared_distance(slot, centroid);
+      if (distance < best) {
+        best = distance;
+        current.representative = slot;
+      }
+    };
+    if (current.leaf()) {
+      for (index slot = current.first; slot < current.first + current.count;
+           ++slot)
+        consider(slot);
+    } else {
+      for (index c = 0; c < current.child_count; ++c)
+        consider(nodes[current.first_child + c].representative);
+    }
+  }
+
+  // A point of the subtree inside area, preferring representatives.
+  bool find_inside(const node &current, const box &area, index &slot) const {
+    if (area.contains(slot_point(current.representative))) {
+      slot = current.representative;
+      return true;
+    }
+    if (current.leaf()) {
+      for (index s = current.first; s < current.first + current.count; ++s)
+        if (area.contains(slot_point(s))) {
+          slot = s;
+          return true;
+        }
+      return false;
+    }
+    for (index c = 0; c < current.child_count; ++c) {
+      const node &child = nodes[current.first_child + c];
+      if (child.bounds.overlaps(area) && find_inside(child, area, slot))
+        return true;
+    }
+    return false;
+  }
+
+  void init(const PointCloud<T, 3> &cloud, size_t bucket, size_t threads) {
+    if (bucket == 0)
+      throw std::invalid_argument("Octree bucket size must be positive.");
+    if (cloud.size() >= std::numeric_limits<index>::max())
+      throw std::length_error("Too many points for Octree");
+    bucket_size = bucket;
+    if (cloud.empty())
+      return;
+
+    std::vector<curve_key> keys = curve_keys(cloud, curve::morton, threads);
+    std::vector<size_t> order = detail::key_order(keys, threads);
+
+    points.resize(cloud.size());
+    indices.resize(cloud.size());
+    std::vector<curve_key> sorted_keys(cloud.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      indices[i] = static_cast<index>(order[i]);
+      sorted_keys[i] = keys[order[i]];
+    }
+    for (size_t d = 0; d < 3; ++d) {
+      const T *in = cloud.axis_data(d);
+      T *out = points.axis_data(d);
+      for (size_t i = 0; i < order.size(); ++i)
+        out[i] = in[order[i]];
+    }
+    build(sorted_keys, threads);
+  }
+
+public:
+  Octree() = default;
+
+  // threads == 0 uses every hardware thread for the build.
+  explicit Octree(const PointCloud<T, 3> &cloud,
+                  size_t bucket = default_bucket_size, size_t threads = 1) {
+    init(cloud, bucket, threads);
+  }
+
+  explicit Octree(const std::vector<point> &input,
+                  size_t bucket = default_bucket_size, size_t threads = 1) {
+    init(PointCloud<T, 3>(input), bucket, threads);
+  }
+
+  size_t size() const { return indices.size(); }
+  bool empty() const { return indices.empty(); }
+  size_t node_count() const { return nodes.size(); }
+
+  // Every point with |p - center| <= radius, in no particular order.
+  std::vector<neighbour> within_radius(const point &center,
+                                       real radius) const {
+    std::vector<neighbour> result;
+    if (empty() || radius < 0)
+      return result;
+    real limit = radius * radius;
+    std::vector<index> stack{0};
+    while (!stack.empty()) {
+      const node &current = nodes[stack.back()];
+      stack.pop_back();
+      if (current.bounds.squared_distance(center) > limit)
+        continue;
+      if (current.leaf()) {
+        for (index s = current.first; s < current.first + current.count;
+             ++s) {
+          real distance = slot_squared_distance(s, center);
+          if (distance <= limit)
+            result.push_back({indices[s], distance});
+        }
+      } else {
+        for (index c = 0; c < current.child_count; ++c)
+          stack.push_back(current.first_child + c);
+      }
+    }
+    return result;
+  }
+
+  // The k closest points, nearest first (best-first search).
+  std::vector<neighbour> nearest(const point &query, size_t k) const {
+    std::vector<neighbour> result;
+    if (k == 0 || empty())
+      return result;
+
+    struct candidate {
+      real squared_distance;
+      index id; // node, or sorted slot when is_point
+      bool is_point;
+      bool operator>(const candidate &other) const {
+        return squared_distance > other.squared_distance;
+      }
+    };
+    std::priority_queue<candidate, std::vector<candidate>, std::greater<>>
+        queue;
+    queue.push({0, 0, false});
+    while (!queue.empty() && result.size() < k) {
+      candidate top = queue.top();
+      queue.pop();
+      if (top.is_point) {
+        result.push_back({indices[top.id], top.squared_distance});
+        continue;
+      }
+      const node &current = nodes[top.id];
+      if (current.leaf()) {
+        for (index s = current.first; s < current.first + current.count; ++s)
+          queue.push({slot_squared_distance(s, query), s, true});
+      } else {
+        for (index c = 0; c < current.child_count; ++c) {
+          index child = current.first_child + c;
+          queue.push({nodes[child].bounds.squared_distance(query), child,
+                      false});
+        }
+      }
+    }
+    return result;
+  }
+
+  // Indices of the points inside the closed box, in no particular order.
+  std::vector<size_t> in_box(const box &area) const {
+    std::vector<size_t> result;
+    if (empty())
+      return result;
+    std::vector<index> stack{0};
+    while (!stack.empty()) {
+      const node &current = nodes[stack.back()];
+      stack.pop_back();
+      if (!current.bounds.overlaps(area))
+        continue;
+      bool whole = area.contains(current.bounds);
+      if (whole || current.leaf()) {
+        for (index s = current.first; s < current.first + current.count; ++s)
+          if (whole || area.contains(slot_point(s)))
+            result.push_back(indices[s]);
+      } else {
+        for (index c = 0; c < current.child_count; ++c)
+          stack.push_back(current.first_child + c);
+      }
+    }
+    return result;
+  }
+
+  // At most max_points indices of points inside the box, spread over it.
+  // Nodes overlapping the box are refined level by level while the result
+  // still fits; each node left unrefined contributes one representative.
+  // If the box holds at most max_points points, all of them are returned.
+  std::vector<size_t> representatives(const box &area,
+                                      size_t max_points) const {
+    std::vector<size_t> result;
+    if (empty() || max_points == 0 || !nodes[0].bounds.overlaps(area))
+      return result;
+
+    std::vector<index> frontier{0};
+    while (!frontier.empty()) {
+      std::vector<index> next;
+      std::vector<size_t> found;
+      for (index n : frontier) {
+        const node &current = nodes[n];
+        if (current.leaf()) {
+          for (index s = current.first; s < current.first + current.count;
+               ++s)
+            if (area.contains(slot_point(s)))
+              found.push_back(indices[s]);
+        } else {
+          for (index c = 0; c < current.child_count; ++c)
+            if (nodes[current.first_child + c].bounds.overlaps(area))
+              next.push_back(current.first_child + c);
+        }
+      }
+      if (result.size() + found.size() + next.size() > max_points)
+        break;
+      result.insert(result.end(), found.begin(), found.end());
+      frontier = std::move(next);
+    }
+
+    for (index n : frontier) {
+      index slot;
+      if (find_inside(nodes[n], area, slot))
+        result.push_back(indices[slot]);
+    }
+    return result;
+  }
+};
+
+} // namespace GeomCPP
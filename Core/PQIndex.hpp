@@ -0,0 +1,294 @@
+#pragma once
+#include "./Parallel.hpp"
+#include "./ProductQuantizer.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace GeomCPP {
+
+namespace detail {
+
+// Keeps the k smallest (distance, id) pairs seen so far as a max-heap.
+struct pq_top_k {
+  struct entry {
+    float squared_distance;
+    size_t index;
+    bool operator<(const entry &other) const {
+      return squared_distance < other.squared_distance;
+    }
+  };
+
+  size_t k;
+  std::vector<entry> heap;
+
+  explicit pq_top_k(size_t limit) : k(limit) { heap.reserve(limit + 1); }
+
+  void offer(float distance, size_t id) {
+    if (heap.size() < k) {
+      heap.push_back({distance, id});
+      std::push_heap(heap.begin(), heap.end());
+    } else if (distance < heap.front().squared_distance) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = {distance, id};
+      std::push_heap(heap.begin(), heap.end());
+    }
+  }
+
+  // Scans codes through the quantizer in blocks, offering ids[i] (or
+  // first_id + i when ids is empty) for each.
+  template <typename Quantizer>
+  void scan(const Quantizer &pq, std::span<const float> table,
+            std::span<const std::uint8_t> codes,
+            std::span<const size_t> ids, size_t first_id) {
+    constexpr size_t block = 256;
+    std::array<float, block> distances;
+    size_t count = codes.size() / pq.code_size();
+    for (size_t lo = 0; lo < count; lo += block) {
+      size_t n = std::min(block, count - lo);
+      pq.asymmetric_distances(
+          table, codes.subspan(lo * pq.code_size(), n * pq.code_size()),
+          std::span<float>(distances.data(), n));
+      for (size_t i = 0; i < n; ++i)
+        offer(distances[i], ids.empty() ? first_id + lo + i : ids[lo + i]);
+    }
+  }
+
+  template <typename Neighbour> std::vector<Neighbour> sorted() {
+    std::sort_heap(heap.begin(), heap.end());
+    std::vector<Neighbour> result;
+    result.reserve(heap.size());
+    for (const entry &e : heap)
+      result.push_back({e.index, e.squared_distance});
+    return result;
+  }
+};
+
+} // namespace detail
+
+// Exhaustive search over product-quantized codes: every stored code is
+// scored against the query's distance table.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class PQIndex {
+public:
+  using point = Point<T, Dim>;
+  using quantizer = ProductQuantizer<T, Dim>;
+
+  struct neighbour {
+    size_t index; // insertion order
+    float squared_distance; // approximate
+  };
+
+  // Queries handed to one thread at a time by the batched search.
+  static constexpr size_t parallel_grain = 16;
+
+private:
+  quantizer pq;
+  std::vector<std::uint8_t> codes;
+
+public:
+  explicit PQIndex(quantizer trained) : pq(std::move(trained)) {
+    if (!pq.trained())
+      throw std::invalid_argument("PQIndex needs a trained quantizer.");
+  }
+
+  size_t size() const { return codes.size() / pq.code_size(); }
+  bool empty() const { return codes.empty(); }
+  const quantizer &get_quantizer() const { return pq; }
+
+  // Encodes and appends the points; threads == 0 uses every hardware thread.
+  void add(std::span<const point> points, size_t threads = 0) {
+    std::vector<std::uint8_t> added = pq.encode(points, threads);
+    codes.insert(codes.end(), added.begin(), added.end());
+  }
+
+  // The k stored points with the smallest approximate distance, nearest
+  // first.
+  std::vector<neighbour> search(const point &query, size_t k) const {
+    if (k == 0 || empty())
+      return {};
+    std::vector<float> table = pq.distance_table(query);
+    detail::pq_top_k best(k);
+    best.scan(pq, table, codes, {}, 0);
+    return best.template sorted<neighbour>();
+  }
+
+  std::vector<std::vector<neighbour>> search(std::span<const point> queries,
+                                             size_t k,
+                                             size_t threads = 0) const {
+    std::vector<std::vector<neighbour>> results(queries.size());
+    parallel_for(
+        0, queries.size(), parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t q = begin; q < end; ++q)
+            results[q] = search(queries[q], k);
+        },
+        threads);
+    return results;
+  }
+};
+
+// Inverted-file index over product-quantized residuals. A coarse k-means
+// quantizer splits the space into lists; each point is stored in the list of
+// its nearest coarse centroid as the PQ code of its offset from that
+// centroid. A query scans only the nprobe lists whose centroids are closest.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class IVFPQIndex {
+public:
+  using point = Point<T, Dim>;
+  using neighbour = typename PQIndex<T, Dim>::neighbour;
+
+  static constexpr size_t parallel_grain = 16;
+
+private:
+  using residual = Point<float, Dim>;
+
+  size_t lists;
+  std::vector<float> centroids; // [list][Dim]
+  ProductQuantizer<float, Dim> pq;
+  std::vector<std::vector<std::uint8_t>> list_codes;
+  std::vector<std::vector<size_t>> list_ids;
+  size_t count = 0;
+
+  static std::array<float, Dim> to_float(const point &p) {
+    std::array<float, Dim> x;
+    for (size_t d = 0; d < Dim; ++d)
+      x[d] = static_cast<float>(p.coordinate(d));
+    return x;
+  }
+
+  residual offset(const std::array<float, Dim> &x, size_t list) const {
+    std::array<float, Dim> r;
+    for (size_t d = 0; d < Dim; ++d)
+      r[d] = x[d] - centroids[list * Dim + d];
+    return residual(r);
+  }
+
+  size_t assign(const std::array<float, Dim> &x) const {
+    return detail::nearest_centroid(centroids.data(), lists, Dim, x.data());
+  }
+
+  void check_trained() const {
+    if (!trained())
+      throw std::runtime_error("IVFPQIndex is not trained.");
+  }
+
+public:
+  IVFPQIndex(size_t list_count, size_t sub_quantizers)
+      : lists(list_count), pq(sub_quantizers) {
+    if (list_count == 0)
+      throw std::invalid_argument("IVFPQIndex needs at least one list.");
+  }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  size_t list_count() const { return lists; }
+  bool trained() const { return pq.trained(); }
+
+  // Trains the coarse quantizer, then the product quantizer on the
+  // residuals. Needs at least max(lists, 256) samples.
+  void train(std::span<const point> samples, size_t iterations = 25,
+             std::uint64_t seed = 42, size_t threads = 0) {
+    std::vector<float> data(samples.size() * Dim);
+    for (size_t i = 0; i < samples.size(); ++i)
+      for (size_t d = 0; d < Dim; ++d)
+        data[i * Dim + d] = static_cast<float>(samples[i].coordinate(d));
+    centroids = detail::kmeans(data.data(), samples.size(), Dim, lists,
+                               iterations, seed, threads);
+
+    std::vector<residual> residuals(samples.size(),
+                                    residual(std::array<float, Dim>{}));
+    parallel_for(
+        0, samples.size(), 256,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            auto x = to_float(samples[i]);
+            residuals[i] = offset(x, assign(x));
+          }
+        },
+        threads);
+    pq.train(residuals, iterations, seed, threads);
+    list_codes.assign(lists, {});
+    list_ids.assign(lists, {});
+    count = 0;
+  }
+
+  // Appends the points; ids continue from size().
+  void add(std::span<const point> points, size_t threads = 0) {
+    check_trained();
+    std::vector<std::uint32_t> assigned(points.size());
+    std::vector<std::uint8_t> codes(points.size() * pq.code_size());
+    parallel_for(
+        0, points.size(), 64,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            auto x = to_float(points[i]);
+            size_t list = assign(x);
+            assigned[i] = static_cast<std::uint32_t>(list);
+            pq.encode(offset(x, list),
+                      std::span<std::uint8_t>(codes.data() +
+                                                  i * pq.code_size(),
+                                              pq.code_size()));
+          }
+        },
+        threads);
+    for (size_t i = 0; i < points.size(); ++i) {
+      auto code = codes.begin() + i * pq.code_size();
+      list_codes[assigned[i]].insert(list_codes[assigned[i]].end(), code,
+                                     code + pq.code_size());
+      list_ids[assigned[i]].push_back(count + i);
+    }
+    count += points.size();
+  }
+
+  // The k best approximate matches among the nprobe closest lists, nearest
+  // first.
+  std::vector<neighbour> search(const point &query, size_t k,
+                                size_t nprobe = 1) const {
+    check_trained();
+    if (k == 0 || empty())
+      return {};
+    nprobe = std::clamp<size_t>(nprobe, 1, lists);
+    auto x = to_float(query);
+
+    std::vector<std::pair<float, size_t>> coarse(lists);
+    for (size_t l = 0; l < lists; ++l)
+      coarse[l] = {detail::row_squared_distance(
+                       x.data(), centroids.data() + l * Dim, Dim),
+                   l};
+    std::partial_sort(coarse.begin(), coarse.begin() + nprobe, coarse.end());
+
+    detail::pq_top_k best(k);
+    for (size_t p = 0; p < nprobe; ++p) {
+      size_t list = coarse[p].second;
+      if (list_ids[list].empty())
+        continue;
+      std::vector<float> table = pq.distance_table(offset(x, list));
+      best.scan(pq, table, list_codes[list], list_ids[list], 0);
+    }
+    return best.template sorted<neighbour>();
+  }
+
+  std::vector<std::vector<neighbour>> search(std::span<const point> queries,
+                                             size_t k, size_t nprobe = 1,
+                                             size_t threads = 0) const {
+    std::vector<std::vector<neighbour>> results(queries.size());
+    parallel_for(
+        0, queries.size(), parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t q = begin; q < end; ++q)
+            results[q] = search(queries[q], k, nprobe);
+        },
+        threads);
+    return results;
+  }
+};
+
+} // namespace GeomCPP
@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GeomCPP {
+
+// Number of worker threads used when a caller passes 0 as thread count.
+inline size_t default_thread_count() {
+  size_t hardware = std::thread::hardware_concurrency();
+  return hardware == 0 ? 1 : hardware;
+}
+
+// Splits [begin, end) into chunks of at most grain elements and hands them out
+// dynamically to a pool of threads; body is invoked as body(chunk_begin,
+// chunk_end). The first exception thrown by any chunk is rethrown here.
+template <typename Body>
+void parallel_for(size_t begin, size_t end, size_t grain, Body &&body,
+                  size_t threads = 0) {
+  if (begin >= end)
+    return;
+  if (grain == 0)
+    grain = 1;
+  if (threads == 0)
+    threads = default_thread_count();
+
+  size_t chunks = (end - begin + grain - 1) / grain;
+  threads = std::min(threads, chunks);
+
+  if (threads <= 1) {
+    for (size_t lo = begin; lo < end; lo += grain)
+      body(lo, std::min(lo + grain, end));
+    return;
+  }
+
+  std::atomic<size_t> next_chunk{0};
+  std::exception_ptr failure;
+  std::mutex failure_mutex;
+
+  auto worker = [&]() {
+    for (;;) {
+      size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= chunks)
+        return;
+      size_t lo = begin + chunk * grain;
+      try {
+        body(lo, std::min(lo + grain, end));
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(failure_mutex);
+        if (!failure)
+          failure = std::current_exception();
+        next_chunk.store(chunks, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (size_t t = 1; t < threads; ++t)
+    pool.emplace_back(worker);
+  worker();
+  for (auto &thread : pool)
+    thread.join();
+
+  if (failure)
+    std::rethrow_exception(failure);
+}
+
+// Runs below this length are not worth a thread of their own.
+inline constexpr size_t parallel_sort_min_run = 4096;
+
+// Sorts one run per thread, then merges neighbouring runs pairwise, each
+// merge round spread over the pool. Not stable.
+template <typename Iterator, typename Compare = std::less<>>
+void parallel_sort(Iterator first, Iterator last, Compare compare = {},
+                   size_t threads = 0) {
+  size_t count = static_cast<size_t>(std::distance(first, last));
+  if (threads == 0)
+    threads = default_thread_count();
+  size_t runs = std::min(threads, count / parallel_sort_min_run);
+  if (runs <= 1) {
+    std::sort(first, last, compare);
+    return;
+  }
+
+  size_t run = (count + runs - 1) / runs;
+  parallel_for(
+      0, runs, 1,
+      [&](size_t lo, size_t hi) {
+        for (size_t r = lo; r < hi; ++r)
+          std::sort(first + r * run, first + std::min((r + 1) * run, count),
+                    compare);
+      },
+      threads);
+
+  for (size_t width = run; width < count; width *= 2) {
+    size_t pairs = (count + 2 * width - 1) / (2 * width);
+    parallel_for(
+        0, pairs, 1,
+        [&](size_t lo, size_t hi) {
+          for (size_t p = lo; p < hi; ++p) {
+            size_t begin = p * 2 * width;
+            size_t middle = std::min(begin + width, count);
+            size_t end = std::min(begin + 2 * width, count);
+            if (middle < end)
+              std::inplace_merge(first + begin, first + middle, first + end,
+                                 compare);
+          }
+        },
+        threads);
+  }
+}
+
+} // namespace GeomCPP
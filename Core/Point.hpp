@@ -1,10 +1,15 @@
 #pragma once
+#include "./Constexpr_math.hpp"
+#include "./Point_expression.hpp"
 #include "./Point_traits.hpp"
+#include "./Predicates.hpp"
+#include "./Simd_dispatch.hpp"
 #include <array>
 #include <cmath>
 #include <concepts>
 #include <iostream>
 #include <stdexcept>
+#include <type_traits>
 
 namespace GeomCPP {
 
@@ -13,6 +18,8 @@ template <typename T, size_t Dim>
 class Point {
 public:
   using point = Point<T, Dim>;
+  using value_type = T;
+  using accumulator = accumulate_t<T>;
   using iterator = typename std::array<T, Dim>::iterator;
   using const_iterator = typename std::array<T, Dim>::const_iterator;
 
@@ -21,83 +28,116 @@ private:
   size_t dimensions;
 
 public:
-  std::array<T, Dim> get_coordinates() const { return coordinates; }
-  iterator begin() { return coordinates.begin(); }
-  iterator end() { return coordinates.end(); }
-  const_iterator begin() const { return coordinates.begin(); }
-  const_iterator end() const { return coordinates.end(); }
-  const_iterator cbegin() const { return coordinates.cbegin(); }
-  const_iterator cend() const { return coordinates.cend(); }
+  constexpr std::array<T, Dim> get_coordinates() const { return coordinates; }
+  constexpr iterator begin() { return coordinates.begin(); }
+  constexpr iterator end() { return coordinates.end(); }
+  constexpr const_iterator begin() const { return coordinates.begin(); }
+  constexpr const_iterator end() const { return coordinates.end(); }
+  constexpr const_iterator cbegin() const { return coordinates.cbegin(); }
+  constexpr const_iterator cend() const { return coordinates.cend(); }
 
   [[nodiscard]] inline static constexpr size_t get_dimensions() { return Dim; };
 
-  Point(std::array<T, Dim> init) : coordinates(init), dimensions(init.size()) {}
-
-  point operator+(const point &other) const {
-    point result = *this;
+  constexpr Point(std::array<T, Dim> init)
+      : coordinates(init), dimensions(init.size()) {}
+
+  // Arithmetic on points (+, -, scalar * and /) builds a lazy expression;
+  // these evaluate it in a single pass over the coordinates.
+  template <typename Expression>
+    requires(!std::is_same_v<Expression, point> &&
+             point_expression<Expression> &&
+             std::is_same_v<typename Expression::value_type, T> &&
+             Expression::get_dimensions() == Dim)
+  constexpr Point(const Expression &expression)
+      : coordinates{}, dimensions(Dim) {
     for (size_t i = 0; i < Dim; ++i)
-      result.coordinates[i] += other.coordinates[i];
-    return result;
+      coordinates[i] = expression.coordinate(i);
   }
 
-  point operator-(const point &other) const {
-    point result = *this;
+  template <typename Expression>
+    requires(!std::is_same_v<Expression, point> &&
+             point_expression<Expression> &&
+             std::is_same_v<typename Expression::value_type, T> &&
+             Expression::get_dimensions() == Dim)
+  constexpr point &operator=(const Expression &expression) {
     for (size_t i = 0; i < Dim; ++i)
-      result.coordinates[i] -= other.coordinates[i];
-    return result;
+      coordinates[i] = expression.coordinate(i);
+    return *this;
   }
 
-  T operator[](size_t index) const {
+  // Unchecked access used by expression evaluation.
+  constexpr T coordinate(size_t index) const { return coordinates[index]; }
+
+  constexpr T operator[](size_t index) const {
     return coordinates.at(index); // Use .at() for bounds checking
   }
 
-  point &operator=(const point &other) {
+  constexpr point &operator=(const point &other) {
     coordinates = other.coordinates;
     return *this;
   }
 
-  T dot(const point &other) const {
-    T result = 0;
+  constexpr accumulator dot(const point &other) const {
+    if constexpr (simd_element<T> && Dim >= simd_dispatch_threshold) {
+      if (!std::is_constant_evaluated())
+        return simd_dot(coordinates.data(), other.coordinates.data(), Dim);
+    }
+
+    accumulator result = 0;
     for (size_t i = 0; i < Dim; ++i)
-      result += coordinates[i] * other.coordinates[i];
+      result += static_cast<accumulator>(coordinates[i]) *
+                static_cast<accumulator>(other.coordinates[i]);
     return result;
   }
 
-  bool operator==(const point &other) const {
-    for (size_t i = 0; i < Dim; ++i) {
-      if (std::abs(coordinates[i] - other.coordinates[i]) > 1e-9)
-        return false;
+  constexpr bool operator==(const point &other) const {
+    if constexpr (std::integral<T>) {
+      return coordinates == other.coordinates;
+    } else {
+      for (size_t i = 0; i < Dim; ++i) {
+        if (constexpr_abs(static_cast<accumulator>(coordinates[i]) -
+                          static_cast<accumulator>(other.coordinates[i])) >
+            1e-9)
+          return false;
+      }
+      return true;
     }
-    return true;
   }
 
-  T distance(const point &other) const {
-    T dist = 0;
-    for (size_t i = 0; i < Dim; ++i)
-      dist += (coordinates[i] - other.coordinates[i]) *
-              (coordinates[i] - other.coordinates[i]);
-    return std::sqrt(dist);
-  }
+  constexpr accumulator squared_distance(const point &other) const {
+    if constexpr (simd_element<T> && Dim >= simd_dispatch_threshold) {
+      if (!std::is_constant_evaluated())
+        return simd_squared_distance(coordinates.data(),
+                                     other.coordinates.data(), Dim);
+    }
 
-  T magnitude() const { return distance(point{std::array<T, Dim>{}}); }
-  point operator/(const T scalar) const {
-    if (scalar == 0)
-      throw std::runtime_error("Division by zero");
+    accumulator dist = 0;
+    for (size_t i = 0; i < Dim; ++i) {
+      accumulator diff = static_cast<accumulator>(coordinates[i]) -
+                         static_cast<accumulator>(other.coordinates[i]);
+      dist += diff * diff;
+    }
+    return dist;
+  }
 
-    point result = *this;
-    for (size_t counter = 0; counter < Dim; ++counter)
-      result.coordinates[counter] = coordinates[counter] / scalar;
+  constexpr accumulator distance(const point &other) const {
+    return constexpr_sqrt(squared_distance(other));
+  }
 
-    return result;
+  constexpr accumulator magnitude() const {
+    if constexpr (simd_element<T> && Dim >= simd_dispatch_threshold)
+      return constexpr_sqrt(dot(*this));
+    else
+      return distance(point{std::array<T, Dim>{}});
   }
 
-  template <valid_scalar ScalarType> void scale(ScalarType scalar) {
+  template <valid_scalar ScalarType> constexpr void scale(ScalarType scalar) {
     for (auto &coord : coordinates)
       coord *= scalar;
   }
 
-  Point<T, Dim> reflect(const Point<T, Dim> &line_point1,
-                        const Point<T, Dim> &line_point2) const
+  constexpr Point<T, Dim> reflect(const Point<T, Dim> &line_point1,
+                                  const Point<T, Dim> &line_point2) const
     requires(Dim == 2)
   {
     Point<T, Dim> result = *this;
@@ -118,8 +158,8 @@ public:
     return result;
   }
 
-  Point<T, Dim> reflect(const Point<T, Dim> &plane_point,
-                        const Point<T, Dim> &plane_normal) const
+  constexpr Point<T, Dim> reflect(const Point<T, Dim> &plane_point,
+                                  const Point<T, Dim> &plane_normal) const
     requires(Dim == 3)
   {
     point result = *this;
@@ -156,10 +196,16 @@ public:
 
   template <typename P1, typename P2, typename P3>
     requires same_length_points<P1, P2, P3>
-  static bool collinear(const P1 &p1, const P2 &p2, const P3 &p3) {
-    auto determinant =
-        (p2[0] - p1[0]) * (p3[1] - p1[1]) - (p2[1] - p1[1]) * (p3[0] - p1[0]);
-    return std::abs(determinant) < 1e-9;
+  static constexpr bool collinear(const P1 &p1, const P2 &p2, const P3 &p3) {
+    // orientation_sign takes a single coordinate type; widen mixed points.
+    using common =
+        std::common_type_t<typename P1::value_type, typename P2::value_type,
+                           typename P3::value_type>;
+    auto c = [](const auto &p, size_t axis) {
+      return static_cast<common>(p[axis]);
+    };
+    return orientation_sign(c(p1, 0), c(p1, 1), c(p2, 0), c(p2, 1), c(p3, 0),
+                            c(p3, 1)) == 0;
   }
 };
 
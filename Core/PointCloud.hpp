@@ -0,0 +1,295 @@
+#pragma once
+#include "./Point.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace GeomCPP {
+
+// Allocator returning storage aligned to a full cache line so every axis of a
+// PointCloud starts on a boundary suitable for the widest vector loads.
+template <typename T, size_t Alignment = 64> struct aligned_allocator {
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() noexcept = default;
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Alignment> &) noexcept {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T *ptr, size_t) noexcept {
+    ::operator delete(ptr, std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  bool operator==(const aligned_allocator<U, Alignment> &) const noexcept {
+    return true;
+  }
+};
+
+// Structure-of-arrays container: coordinate d of every point lives in its own
+// contiguous, aligned array so batched kernels run as one flat loop per axis.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class PointCloud {
+public:
+  using point = Point<T, Dim>;
+  using accumulator = accumulate_t<T>;
+  using axis_storage = std::vector<T, aligned_allocator<T>>;
+
+private:
+  std::array<axis_storage, Dim> axes;
+  size_t count = 0;
+
+  void check_same_size(const PointCloud &other) const {
+    if (count != other.count)
+      throw std::invalid_argument("Point clouds must have the same size.");
+  }
+
+public:
+  PointCloud() = default;
+
+  explicit PointCloud(size_t size) : count(size) {
+    for (auto &axis : axes)
+      axis.resize(size);
+  }
+
+  PointCloud(const std::vector<point> &points) : PointCloud(points.size()) {
+    for (size_t i = 0; i < count; ++i)
+      set_point(i, points[i]);
+  }
+
+  [[nodiscard]] inline static constexpr size_t get_dimensions() { return Dim; }
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  T *axis_data(size_t dimension) { return axes.at(dimension).data(); }
+  const T *axis_data(size_t dimension) const {
+    return axes.at(dimension).data();
+  }
+
+  void reserve(size_t capacity) {
+    for (auto &axis : axes)
+      axis.reserve(capacity);
+  }
+
+  void resize(size_t size) {
+    for (auto &axis : axes)
+      axis.resize(size);
+    count = size;
+  }
+
+  void clear() { resize(0); }
+
+  void push_back(const point &p) {
+    for (size_t d = 0; d < Dim; ++d)
+      axes[d].push_back(p[d]);
+    ++count;
+  }
+
+  point get_point(size_t index) const {
+    if (index >= count)
+      throw std::out_of_range("Point cloud index out of range");
+
+    std::array<T, Dim> coords;
+    for (size_t d = 0; d < Dim; ++d)
+      coords[d] = axes[d][index];
+    return point(coords);
+  }
+
+  point operator[](size_t index) const { return get_point(index); }
+
+  void set_point(size_t index, const point &p) {
+    if (index >= count)
+      throw std::out_of_range("Point cloud index out of range");
+
+    for (size_t d = 0; d < Dim; ++d)
+      axes[d][index] = p[d];
+  }
+
+  std::vector<point> to_points() const {
+    std::vector<point> points;
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+      points.push_back(get_point(i));
+    return points;
+  }
+
+  PointCloud operator+(const PointCloud &other) const {
+    check_same_size(other);
+    PointCloud result(count);
+    for (size_t d = 0; d < Dim; ++d) {
+      const T *lhs = axes[d].data();
+      const T *rhs = other.axes[d].data();
+      T *out = result.axes[d].data();
+      for (size_t i = 0; i < count; ++i)
+        out[i] = lhs[i] + rhs[i];
+    }
+    return result;
+  }
+
+  PointCloud operator-(const PointCloud &other) const {
+    check_same_size(other);
+    PointCloud result(count);
+    for (size_t d = 0; d < Dim; ++d) {
+      const T *lhs = axes[d].data();
+      const T *rhs = other.axes[d].data();
+      T *out = result.axes[d].data();
+      for (size_t i = 0; i < count; ++i)
+        out[i] = lhs[i] - rhs[i];
+    }
+    return result;
+  }
+
+  // Translate every point of the cloud by the same offset.
+  PointCloud operator+(const point &offset) const {
+    PointCloud result(count);
+    for (size_t d = 0; d < Dim; ++d) {
+      const T *lhs = axes[d].data();
+      const T shift = offset[d];
+      T *out = result.axes[d].data();
+      for (size_t i = 0; i < count; ++i)
+        out[i] = lhs[i] + shift;
+    }
+    return result;
+  }
+
+  PointCloud operator-(const point &offset) const {
+    PointCloud result(count);
+    for (size_t d = 0; d < Dim; ++d) {
+      const T *lhs = axes[d].data();
+      const T shift = offset[d];
+      T *out = result.axes[d].data();
+      for (size_t i = 0; i < count; ++i)
+        out[i] = lhs[i] - shift;
+    }
+    return result;
+  }
+
+  // Pairwise dot product of point i of this cloud with point i of other.
+  std::vector<accumulator> dot(const PointCloud &other) const {
+    check_same_size(other);
+    std::vector<accumulator> result(count, accumulator{0});
+    accumulator *out = result.data();
+    for (size_t d = 0; d < Dim; ++d) {
+      const T *lhs = axes[d].data();
+      const T *rhs = other.axes[d].data();
+      for (size_t i = 0; i < count; ++i)
+        out[i] += static_cast<accumulator>(lhs[i]) *
+                  static_cast<accumulator>(rhs[i]);
+    }
+    return result;
+  }
+
+  std::vector<accumulator> dot(const point &other) const {
+    std::vector<accumulator> result(count, accumulator{0});
+    accumulator *out = result.data();
+    for (size_t d = 0; d < Dim; ++d) {
+      const T *lhs = axes[d].data();
+      const accumulator rhs = other[d];
+      for (size_t i = 0; i < count; ++i)
+        out[i] += static_cast<accumulator>(lhs[i]) * rhs;
+    }
+    return result;
+  }
+
+  // Pairwise distance of point i of this cloud to point i of other.
+  std::vector<accumulator> distance(const PointCloud &other) const {
+    check_same_size(other);
+    std::vector<accumulator> result(count, accumulator{0});
+    accumulator *out = result.data();
+    for (size_t d = 0; d < Dim; ++d) {
+      const T *lhs = axes[d].data();
+      const T *rhs = other.axes[d].data();
+      for (size_t i = 0; i < count; ++i) {
+        accumulator diff = static_cast<accumulator>(lhs[i]) -
+                           static_cast<accumulator>(rhs[i]);
+        out[i] += diff * diff;
+      }
+    }
+    for (size_t i = 0; i < count; ++i)
+      out[i] = std::sqrt(out[i]);
+    return result;
+  }
+
+  std::vector<accumulator> distance(const point &other) const {
+    std::vector<accumulator> result(count, accumulator{0});
+    accumulator *out = result.data();
+    for (size_t d = 0; d < Dim; ++d) {
+      const T *lhs = axes[d].data();
+      const accumulator rhs = other[d];
+      for (size_t i = 0; i < count; ++i) {
+        accumulator diff = static_cast<accumulator>(lhs[i]) - rhs;
+        out[i] += diff * diff;
+      }
+    }
+    for (size_t i = 0; i < count; ++i)
+      out[i] = std::sqrt(out[i]);
+    return result;
+  }
+
+  template <valid_scalar ScalarType> void scale(ScalarType scalar) {
+    for (auto &axis : axes) {
+      T *data = axis.data();
+      for (size_t i = 0; i < count; ++i)
+        data[i] *= scalar;
+    }
+  }
+
+  PointCloud operator/(const T scalar) const {
+    if (scalar == 0)
+      throw std::runtime_error("Division by zero");
+
+    PointCloud result(count);
+    for (size_t d = 0; d < Dim; ++d) {
+      const T *lhs = axes[d].data();
+      T *out = result.axes[d].data();
+      for (size_t i = 0; i < count; ++i)
+        out[i] = lhs[i] / scalar;
+    }
+    return result;
+  }
+};
+
+namespace detail {
+
+// Coordinate access for batched kernels that run over either layout: the
+// axis arrays of a PointCloud, or a span of Points read in place at the
+// stride of one Point.
+template <typename T, size_t Dim> struct cloud_coordinates {
+  std::array<T *, Dim> axes;
+
+  GEOMCPP_ALWAYS_INLINE T &operator()(size_t i, size_t d) const {
+    return axes[d][i];
+  }
+};
+
+template <typename T, size_t Dim> struct point_coordinates {
+  Point<T, Dim> *points;
+
+  GEOMCPP_ALWAYS_INLINE T &operator()(size_t i, size_t d) const {
+    return points[i].begin()[d];
+  }
+};
+
+template <typename T, size_t Dim>
+cloud_coordinates<T, Dim> coordinates_of(PointCloud<T, Dim> &cloud) {
+  cloud_coordinates<T, Dim> result;
+  for (size_t d = 0; d < Dim; ++d)
+    result.axes[d] = cloud.axis_data(d);
+  return result;
+}
+
+} // namespace detail
+
+} // namespace GeomCPP
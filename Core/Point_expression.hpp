@@ -0,0 +1,234 @@
+#pragma once
+#include "./Point_traits.hpp"
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace GeomCPP {
+
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class Point;
+
+// Anything that yields Dim coordinates of value_type on demand: a Point
+// itself, or a lazily evaluated arithmetic expression over Points.
+template <typename E>
+concept point_expression = requires(const E &expression, size_t index) {
+  typename E::value_type;
+  { E::get_dimensions() } -> std::convertible_to<size_t>;
+  {
+    expression.coordinate(index)
+  } -> std::convertible_to<typename E::value_type>;
+};
+
+template <typename Lhs, typename Rhs>
+concept compatible_point_expressions =
+    point_expression<Lhs> && point_expression<Rhs> &&
+    std::is_same_v<typename Lhs::value_type, typename Rhs::value_type> &&
+    Lhs::get_dimensions() == Rhs::get_dimensions();
+
+namespace detail {
+
+template <typename E>
+concept expression_node = requires { E::is_expression_node; };
+
+// Stored type of an operand passed as E&& (E deduced by forwarding). Named
+// Points are held by const reference, so a chain such as p1 + p2 - p3 copies
+// no coordinates until it is evaluated; temporary Points and expression
+// nodes are held by value, so a node never refers to an operand that dies at
+// the end of the full expression that built it.
+template <typename E>
+using expression_operand =
+    std::conditional_t<std::is_lvalue_reference_v<E> &&
+                           !expression_node<std::remove_cvref_t<E>>,
+                       const std::remove_cvref_t<E> &, std::remove_cvref_t<E>>;
+
+struct expression_add {
+  template <typename T> static constexpr T apply(T lhs, T rhs) {
+    return static_cast<T>(lhs + rhs);
+  }
+};
+
+struct expression_subtract {
+  template <typename T> static constexpr T apply(T lhs, T rhs) {
+    return static_cast<T>(lhs - rhs);
+  }
+};
+
+struct expression_multiply {
+  template <typename T> static constexpr T apply(T lhs, T rhs) {
+    return static_cast<T>(lhs * rhs);
+  }
+};
+
+struct expression_divide {
+  template <typename T> static constexpr T apply(T lhs, T rhs) {
+    return static_cast<T>(lhs / rhs);
+  }
+};
+
+} // namespace detail
+
+// Common interface of the expression nodes. Member functions that need every
+// coordinate at once materialise the expression into a Point first.
+template <typename Derived, typename T, size_t Dim>
+class point_expression_base {
+public:
+  using value_type = T;
+  static constexpr bool is_expression_node = true;
+
+  [[nodiscard]] inline static constexpr size_t get_dimensions() { return Dim; }
+
+  constexpr Point<T, Dim> eval() const { return Point<T, Dim>(derived()); }
+
+  constexpr T operator[](size_t index) const {
+    if (index >= Dim)
+      throw std::out_of_range("Point index out of range");
+    return derived().coordinate(index);
+  }
+
+  constexpr std::array<T, Dim> get_coordinates() const {
+    return eval().get_coordinates();
+  }
+
+  constexpr auto dot(const Point<T, Dim> &other) const {
+    return eval().dot(other);
+  }
+
+  constexpr auto distance(const Point<T, Dim> &other) const {
+    return eval().distance(other);
+  }
+
+  constexpr auto magnitude() const { return eval().magnitude(); }
+
+  void print() const { eval().print(); }
+
+private:
+  constexpr const Derived &derived() const {
+    return static_cast<const Derived &>(*this);
+  }
+};
+
+// Lhs and Rhs are the stored operand types (see detail::expression_operand).
+//
+// As with Eigen, `auto e = p1 + p2;` deduces the expression, not a Point: it
+// reads p1 and p2 each time it is evaluated, sees later changes to them and
+// dangles once either goes out of scope, e.g. when a function returns an
+// expression over its locals. Assign it to a Point, or call eval(), to keep
+// the result.
+template <typename Lhs, typename Rhs, typename Op>
+class point_binary_expression
+    : public point_expression_base<
+          point_binary_expression<Lhs, Rhs, Op>,
+          typename std::remove_cvref_t<Lhs>::value_type,
+          std::remove_cvref_t<Lhs>::get_dimensions()> {
+private:
+  Lhs lhs;
+  Rhs rhs;
+
+public:
+  template <typename L, typename R>
+  constexpr point_binary_expression(L &&lhs_operand, R &&rhs_operand)
+      : lhs(std::forward<L>(lhs_operand)), rhs(std::forward<R>(rhs_operand)) {}
+
+  constexpr typename std::remove_cvref_t<Lhs>::value_type
+  coordinate(size_t index) const {
+    return Op::apply(lhs.coordinate(index), rhs.coordinate(index));
+  }
+};
+
+template <typename Operand, typename Op>
+class point_scalar_expression
+    : public point_expression_base<
+          point_scalar_expression<Operand, Op>,
+          typename std::remove_cvref_t<Operand>::value_type,
+          std::remove_cvref_t<Operand>::get_dimensions()> {
+public:
+  using value_type = typename std::remove_cvref_t<Operand>::value_type;
+
+private:
+  Operand operand;
+  value_type scalar;
+
+public:
+  template <typename O>
+  constexpr point_scalar_expression(O &&expression_operand,
+                                    value_type scalar_operand)
+      : operand(std::forward<O>(expression_operand)), scalar(scalar_operand) {
+    if constexpr (std::is_same_v<Op, detail::expression_divide>) {
+      if (scalar == 0)
+        throw std::runtime_error("Division by zero");
+    }
+  }
+
+  constexpr value_type coordinate(size_t index) const {
+    return Op::apply(operand.coordinate(index), scalar);
+  }
+};
+
+namespace detail {
+
+template <typename Op, typename Lhs, typename Rhs>
+constexpr auto make_binary_expression(Lhs &&lhs, Rhs &&rhs) {
+  return point_binary_expression<expression_operand<Lhs>,
+                                 expression_operand<Rhs>, Op>(
+      std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename Op, typename Operand>
+constexpr auto make_scalar_expression(
+    Operand &&operand,
+    typename std::remove_cvref_t<Operand>::value_type scalar) {
+  return point_scalar_expression<expression_operand<Operand>, Op>(
+      std::forward<Operand>(operand), scalar);
+}
+
+} // namespace detail
+
+template <typename Lhs, typename Rhs>
+  requires compatible_point_expressions<std::remove_cvref_t<Lhs>,
+                                        std::remove_cvref_t<Rhs>>
+constexpr auto operator+(Lhs &&lhs, Rhs &&rhs) {
+  return detail::make_binary_expression<detail::expression_add>(
+      std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+  requires compatible_point_expressions<std::remove_cvref_t<Lhs>,
+                                        std::remove_cvref_t<Rhs>>
+constexpr auto operator-(Lhs &&lhs, Rhs &&rhs) {
+  return detail::make_binary_expression<detail::expression_subtract>(
+      std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename Operand>
+  requires point_expression<std::remove_cvref_t<Operand>>
+constexpr auto
+operator*(Operand &&operand,
+          typename std::remove_cvref_t<Operand>::value_type scalar) {
+  return detail::make_scalar_expression<detail::expression_multiply>(
+      std::forward<Operand>(operand), scalar);
+}
+
+template <typename Operand>
+  requires point_expression<std::remove_cvref_t<Operand>>
+constexpr auto
+operator*(typename std::remove_cvref_t<Operand>::value_type scalar,
+          Operand &&operand) {
+  return detail::make_scalar_expression<detail::expression_multiply>(
+      std::forward<Operand>(operand), scalar);
+}
+
+template <typename Operand>
+  requires point_expression<std::remove_cvref_t<Operand>>
+constexpr auto
+operator/(Operand &&operand,
+          typename std::remove_cvref_t<Operand>::value_type scalar) {
+  return detail::make_scalar_expression<detail::expression_divide>(
+      std::forward<Operand>(operand), scalar);
+}
+
+} // namespace GeomCPP
@@ -1,4 +1,5 @@
 #pragma once
+#include "./Half.hpp"
 #include <cmath>
 #include <concepts>
 #include <initializer_list>
@@ -9,7 +10,13 @@
 
 namespace GeomCPP {
 template <typename T>
-concept point_numeric = std::is_arithmetic_v<T>;
+concept point_numeric = std::is_arithmetic_v<T> || half_precision<T>;
+
+// Type dot products and distances are accumulated (and returned) in: float
+// for 16-bit storage types, the coordinate type itself otherwise.
+template <typename T>
+using accumulate_t = std::conditional_t<half_precision<T>, float, T>;
+
 template <typename T>
 concept valid_scalar = std::is_same_v<T, int> || std::is_same_v<T, float> ||
                        std::is_same_v<T, double>;
@@ -0,0 +1,350 @@
+#pragma once
+#include "./Constexpr_math.hpp"
+#include "./Exact_int.hpp"
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace GeomCPP {
+
+// Robust geometric predicates after Shewchuk, "Adaptive Precision
+// Floating-Point Arithmetic and Fast Robust Geometric Predicates" (1997).
+// Each predicate first evaluates its determinant in plain double arithmetic
+// and accepts the sign if it exceeds a forward error bound; only the rare
+// near-degenerate inputs are re-evaluated exactly with floating-point
+// expansions. Results are exact as long as no intermediate overflows or
+// underflows. Builds with -ffast-math break these guarantees.
+namespace detail {
+
+inline constexpr double predicate_epsilon = 0x1p-53;
+inline constexpr double cross_error_bound =
+    (3.0 + 16.0 * predicate_epsilon) * predicate_epsilon;
+inline constexpr double orient3d_error_bound =
+    (7.0 + 56.0 * predicate_epsilon) * predicate_epsilon;
+inline constexpr double incircle_error_bound =
+    (10.0 + 96.0 * predicate_epsilon) * predicate_epsilon;
+
+// Non-overlapping sequence of doubles, least significant first, whose exact
+// sum is the represented value. Zero components are eliminated, except that
+// zero itself is stored as a single 0 term.
+template <size_t Capacity> struct expansion {
+  std::array<double, Capacity> terms{};
+  size_t length = 0;
+
+  constexpr int sign() const {
+    double top = terms[length - 1];
+    return (top > 0) - (top < 0);
+  }
+
+  constexpr double estimate() const {
+    double sum = 0;
+    for (size_t i = 0; i < length; ++i)
+      sum += terms[i];
+    return sum;
+  }
+};
+
+constexpr void fast_two_sum(double a, double b, double &sum, double &error) {
+  sum = a + b;
+  double b_virtual = sum - a;
+  error = b - b_virtual;
+}
+
+constexpr void two_sum(double a, double b, double &sum, double &error) {
+  sum = a + b;
+  double b_virtual = sum - a;
+  double a_virtual = sum - b_virtual;
+  error = (a - a_virtual) + (b - b_virtual);
+}
+
+constexpr void two_diff(double a, double b, double &difference,
+                        double &error) {
+  difference = a - b;
+  double b_virtual = a - difference;
+  double a_virtual = difference + b_virtual;
+  error = (a - a_virtual) + (b_virtual - b);
+}
+
+// Exact product as product + error. At run time std::fma gives the error
+// directly (and cannot be broken by floating-point contraction); constant
+// evaluation uses Dekker's splitting.
+constexpr void two_product(double a, double b, double &product,
+                           double &error) {
+  product = a * b;
+  if (!std::is_constant_evaluated()) {
+    error = std::fma(a, b, -product);
+    return;
+  }
+
+  constexpr double splitter = 134217729.0; // 2^27 + 1
+  double big = splitter * a;
+  double a_high = big - (big - a);
+  double a_low = a - a_high;
+  big = splitter * b;
+  double b_high = big - (big - b);
+  double b_low = b - b_high;
+
+  double error1 = product - a_high * b_high;
+  double error2 = error1 - a_low * b_high;
+  double error3 = error2 - a_high * b_low;
+  error = a_low * b_low - error3;
+}
+
+constexpr expansion<2> exact_difference(double a, double b) {
+  expansion<2> result;
+  double difference, error;
+  two_diff(a, b, difference, error);
+  if (error != 0)
+    result.terms[result.length++] = error;
+  result.terms[result.length++] = difference;
+  return result;
+}
+
+// Shewchuk's FAST-EXPANSION-SUM-ZEROELIM.
+template <size_t A, size_t B>
+constexpr expansion<A + B> operator+(const expansion<A> &e,
+                                     const expansion<B> &f) {
+  expansion<A + B> h;
+  size_t ei = 0, fi = 0;
+  double q;
+
+  auto e_smaller = [&]() {
+    return (f.terms[fi] > e.terms[ei]) == (f.terms[fi] > -e.terms[ei]);
+  };
+  auto push = [&](double term) {
+    if (term != 0)
+      h.terms[h.length++] = term;
+  };
+
+  if (e_smaller())
+    q = e.terms[ei++];
+  else
+    q = f.terms[fi++];
+
+  double sum, error;
+  if (ei < e.length && fi < f.length) {
+    if (e_smaller())
+      fast_two_sum(e.terms[ei++], q, sum, error);
+    else
+      fast_two_sum(f.terms[fi++], q, sum, error);
+    q = sum;
+    push(error);
+
+    while (ei < e.length && fi < f.length) {
+      if (e_smaller())
+        two_sum(q, e.terms[ei++], sum, error);
+      else
+        two_sum(q, f.terms[fi++], sum, error);
+      q = sum;
+      push(error);
+    }
+  }
+  while (ei < e.length) {
+    two_sum(q, e.terms[ei++], sum, error);
+    q = sum;
+    push(error);
+  }
+  while (fi < f.length) {
+    two_sum(q, f.terms[fi++], sum, error);
+    q = sum;
+    push(error);
+  }
+  if (q != 0 || h.length == 0)
+    h.terms[h.length++] = q;
+  return h;
+}
+
+template <size_t A> constexpr expansion<A> operator-(expansion<A> e) {
+  for (size_t i = 0; i < e.length; ++i)
+    e.terms[i] = -e.terms[i];
+  return e;
+}
+
+template <size_t A, size_t B>
+constexpr expansion<A + B> operator-(const expansion<A> &e,
+                                     const expansion<B> &f) {
+  return e + -f;
+}
+
+// Shewchuk's SCALE-EXPANSION-ZEROELIM.
+template <size_t A>
+constexpr expansion<2 * A> scale(const expansion<A> &e, double b) {
+  expansion<2 * A> h;
+  auto push = [&](double term) {
+    if (term != 0)
+      h.terms[h.length++] = term;
+  };
+
+  double q, error;
+  two_product(e.terms[0], b, q, error);
+  push(error);
+  for (size_t i = 1; i < e.length; ++i) {
+    double product, product_error, sum;
+    two_product(e.terms[i], b, product, product_error);
+    two_sum(q, product_error, sum, error);
+    push(error);
+    fast_two_sum(product, sum, q, error);
+    push(error);
+  }
+  if (q != 0 || h.length == 0)
+    h.terms[h.length++] = q;
+  return h;
+}
+
+template <size_t A, size_t B>
+constexpr expansion<2 * A * B> operator*(const expansion<A> &e,
+                                         const expansion<B> &f) {
+  expansion<2 * A * B> result;
+  result.terms[result.length++] = 0;
+  for (size_t i = 0; i < f.length; ++i) {
+    auto partial = result + scale(e, f.terms[i]);
+    result.length = partial.length;
+    for (size_t k = 0; k < partial.length; ++k)
+      result.terms[k] = partial.terms[k];
+  }
+  return result;
+}
+
+} // namespace detail
+
+// (b - a) x (d - c): twice the signed area spanned by the directions of the
+// segments ab and cd. The sign is exact; the magnitude is approximate.
+constexpr double direction_cross(double ax, double ay, double bx, double by,
+                                 double cx, double cy, double dx, double dy) {
+  double left = (bx - ax) * (dy - cy);
+  double right = (by - ay) * (dx - cx);
+  double determinant = left - right;
+
+  double magnitude_sum;
+  if (left > 0) {
+    if (right <= 0)
+      return determinant;
+    magnitude_sum = left + right;
+  } else if (left < 0) {
+    if (right >= 0)
+      return determinant;
+    magnitude_sum = -left - right;
+  } else {
+    return determinant;
+  }
+
+  double bound = detail::cross_error_bound * magnitude_sum;
+  if (determinant >= bound || -determinant >= bound)
+    return determinant;
+
+  using detail::exact_difference;
+  auto exact = exact_difference(bx, ax) * exact_difference(dy, cy) -
+               exact_difference(by, ay) * exact_difference(dx, cx);
+  return exact.terms[exact.length - 1];
+}
+
+// Positive if a, b, c wind counter-clockwise, negative if clockwise and zero
+// if they are collinear.
+constexpr double orient2d(double ax, double ay, double bx, double by,
+                          double cx, double cy) {
+  return direction_cross(ax, ay, bx, by, ax, ay, cx, cy);
+}
+
+// Positive if d lies below the plane through a, b, c, where "below" means a,
+// b, c appear counter-clockwise when viewed from above; zero if coplanar.
+constexpr double orient3d(double ax, double ay, double az, double bx,
+                          double by, double bz, double cx, double cy,
+                          double cz, double dx, double dy, double dz) {
+  double adx = ax - dx, bdx = bx - dx, cdx = cx - dx;
+  double ady = ay - dy, bdy = by - dy, cdy = cy - dy;
+  double adz = az - dz, bdz = bz - dz, cdz = cz - dz;
+
+  double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  double cdxady = cdx * ady, adxcdy = adx * cdy;
+  double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+  double determinant = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) +
+                       cdz * (adxbdy - bdxady);
+  double permanent =
+      (constexpr_abs(bdxcdy) + constexpr_abs(cdxbdy)) * constexpr_abs(adz) +
+      (constexpr_abs(cdxady) + constexpr_abs(adxcdy)) * constexpr_abs(bdz) +
+      (constexpr_abs(adxbdy) + constexpr_abs(bdxady)) * constexpr_abs(cdz);
+  double bound = detail::orient3d_error_bound * permanent;
+  if (determinant > bound || -determinant > bound)
+    return determinant;
+
+  using detail::exact_difference;
+  auto eadx = exact_difference(ax, dx), ebdx = exact_difference(bx, dx),
+       ecdx = exact_difference(cx, dx);
+  auto eady = exact_difference(ay, dy), ebdy = exact_difference(by, dy),
+       ecdy = exact_difference(cy, dy);
+  auto eadz = exact_difference(az, dz), ebdz = exact_difference(bz, dz),
+       ecdz = exact_difference(cz, dz);
+
+  auto exact = eadz * (ebdx * ecdy - ecdx * ebdy) +
+               ebdz * (ecdx * eady - eadx * ecdy) +
+               ecdz * (eadx * ebdy - ebdx * eady);
+  return exact.terms[exact.length - 1];
+}
+
+// Positive if d lies inside the circle through a, b, c (given in
+// counter-clockwise order), negative if outside, zero if cocircular.
+constexpr double incircle(double ax, double ay, double bx, double by,
+                          double cx, double cy, double dx, double dy) {
+  double adx = ax - dx, bdx = bx - dx, cdx = cx - dx;
+  double ady = ay - dy, bdy = by - dy, cdy = cy - dy;
+
+  double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  double cdxady = cdx * ady, adxcdy = adx * cdy;
+  double adxbdy = adx * bdy, bdxady = bdx * ady;
+  double alift = adx * adx + ady * ady;
+  double blift = bdx * bdx + bdy * bdy;
+  double clift = cdx * cdx + cdy * cdy;
+
+  double determinant = alift * (bdxcdy - cdxbdy) +
+                       blift * (cdxady - adxcdy) +
+                       clift * (adxbdy - bdxady);
+  double permanent =
+      (constexpr_abs(bdxcdy) + constexpr_abs(cdxbdy)) * alift +
+      (constexpr_abs(cdxady) + constexpr_abs(adxcdy)) * blift +
+      (constexpr_abs(adxbdy) + constexpr_abs(bdxady)) * clift;
+  double bound = detail::incircle_error_bound * permanent;
+  if (determinant > bound || -determinant > bound)
+    return determinant;
+
+  using detail::exact_difference;
+  auto eadx = exact_difference(ax, dx), ebdx = exact_difference(bx, dx),
+       ecdx = exact_difference(cx, dx);
+  auto eady = exact_difference(ay, dy), ebdy = exact_difference(by, dy),
+       ecdy = exact_difference(cy, dy);
+
+  auto exact = (eadx * eadx + eady * eady) * (ebdx * ecdy - ecdx * ebdy) +
+               (ebdx * ebdx + ebdy * ebdy) * (ecdx * eady - eadx * ecdy) +
+               (ecdx * ecdx + ecdy * ecdy) * (eadx * ebdy - ebdx * eady);
+  return exact.terms[exact.length - 1];
+}
+
+// Sign of (b - a) x (d - c). Integers use the exact integer path; every other
+// type is converted to double and goes through the filtered predicate, so the
+// sign is exact for double, float and the 16-bit storage types. long double
+// coordinates are rounded to double first, and the sign is that of the
+// rounded inputs, which may differ from the true sign.
+template <typename T>
+constexpr int cross_sign(T a0, T a1, T b0, T b1, T c0, T c1, T d0, T d1) {
+  if constexpr (std::integral<T>) {
+    return exact_cross_sign(a0, a1, b0, b1, c0, c1, d0, d1);
+  } else {
+    double cross = direction_cross(
+        static_cast<double>(a0), static_cast<double>(a1),
+        static_cast<double>(b0), static_cast<double>(b1),
+        static_cast<double>(c0), static_cast<double>(c1),
+        static_cast<double>(d0), static_cast<double>(d1));
+    return (cross > 0) - (cross < 0);
+  }
+}
+
+// Side of c relative to the line through a and b, with the same exactness as
+// cross_sign.
+template <typename T>
+constexpr int orientation_sign(T a0, T a1, T b0, T b1, T c0, T c1) {
+  return cross_sign(a0, a1, b0, b1, a0, a1, c0, c1);
+}
+
+} // namespace GeomCPP
@@ -0,0 +1,154 @@
+#pragma once
+#include "./BoundingBox.hpp"
+#include "./Line.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace GeomCPP {
+
+// A segment with its setup work done once: the direction end - start, the
+// squared length, its square root and reciprocal, and the bounding box.
+// Repeated queries against the same segment reuse them instead of
+// recomputing end - start per call, and reject points and segments outside
+// the box before any predicate runs. Decisions agree with Line except for
+// floating-point contains, which measures the distance to the segment
+// relative to its length instead of comparing per-axis ratios.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class PreparedLine {
+public:
+  using point = Point<T, Dim>;
+  using line = Line<T, Dim>;
+  using box = BoundingBox<T, Dim>;
+  using real = std::conditional_t<std::is_floating_point_v<accumulate_t<T>>,
+                                  accumulate_t<T>, double>;
+
+  // Relative tolerance of contains for floating-point coordinates: a point
+  // is on the segment when its distance to it is at most tolerance * length.
+  // Line's 1e-9, widened to a few ulps where real is float.
+  static constexpr real tolerance = std::max<real>(
+      real(1e-9), 16 * std::numeric_limits<real>::epsilon());
+
+private:
+  point start;
+  point end;
+  std::array<real, Dim> direction;
+  real squared_length;
+  real segment_length;
+  real inverse_length;
+  box bounds;
+
+  // Sign of (end - start) x (q - p) in the coordinate plane (0, axis). For
+  // double coordinates the cached direction feeds the same forward error
+  // filter as direction_cross; the exact predicate runs only when it fails.
+  constexpr int direction_sign(const point &p, const point &q,
+                               size_t axis = 1) const {
+    if constexpr (std::is_same_v<T, double>) {
+      double left = direction[0] * (q[axis] - p[axis]);
+      double right = direction[axis] * (q[0] - p[0]);
+      double determinant = left - right;
+      if (constexpr_abs(determinant) >
+          detail::cross_error_bound *
+              (constexpr_abs(left) + constexpr_abs(right)))
+        return (determinant > 0) - (determinant < 0);
+    }
+    return cross_sign(start[0], start[axis], end[0], end[axis], p[0],
+                      p[axis], q[0], q[axis]);
+  }
+
+public:
+  constexpr explicit PreparedLine(const line &segment)
+      : start(segment.get_start()), end(segment.get_end()), direction{},
+        squared_length(0), segment_length(0), inverse_length(0),
+        bounds(box::of(segment)) {
+    for (size_t d = 0; d < Dim; ++d) {
+      direction[d] = static_cast<real>(end[d]) - static_cast<real>(start[d]);
+      squared_length += direction[d] * direction[d];
+    }
+    segment_length = constexpr_sqrt(squared_length);
+    inverse_length = 1 / segment_length;
+  }
+
+  constexpr PreparedLine(const point &start_point, const point &end_point)
+      : PreparedLine(line(start_point, end_point)) {}
+
+  constexpr point get_start() const { return start; }
+  constexpr point get_end() const { return end; }
+  constexpr line get_line() const { return line(start, end); }
+  constexpr const std::array<real, Dim> &get_direction() const {
+    return direction;
+  }
+  constexpr real get_squared_length() const { return squared_length; }
+  constexpr real get_inverse_length() const { return inverse_length; }
+  constexpr const box &get_bounds() const { return bounds; }
+
+  constexpr real length() const { return segment_length; }
+
+  // Parameter of the orthogonal projection of p onto the carrying line:
+  // 0 at start, 1 at end, unclamped.
+  constexpr real parameter(const point &p) const {
+    real dot = 0;
+    for (size_t d = 0; d < Dim; ++d)
+      dot += direction[d] * (static_cast<real>(p[d]) -
+                             static_cast<real>(start[d]));
+    return dot * inverse_length * inverse_length;
+  }
+
+  constexpr bool contains(const point &p) const {
+    if constexpr (std::integral<T>) {
+      // Exact, as Line::contains.
+      if (!bounds.contains(p))
+        return false;
+      for (size_t i = 0; i < Dim; ++i)
+        for (size_t j = i + 1; j < Dim; ++j)
+          if (orientation_sign(start[i], start[j], end[i], end[j], p[i],
+                               p[j]) != 0)
+            return false;
+      return true;
+    } else {
+      real slack = tolerance * segment_length;
+      for (size_t d = 0; d < Dim; ++d) {
+        real c = static_cast<real>(p[d]);
+        if (c < static_cast<real>(bounds.lower[d]) - slack ||
+            c > static_cast<real>(bounds.upper[d]) + slack)
+          return false;
+      }
+
+      real t = parameter(p);
+      if (t < -tolerance || t > 1 + tolerance)
+        return false;
+      real squared_offset = 0;
+      for (size_t d = 0; d < Dim; ++d) {
+        real r = static_cast<real>(p[d]) - static_cast<real>(start[d]) -
+                 t * direction[d];
+        squared_offset += r * r;
+      }
+      return squared_offset <= slack * slack;
+    }
+  }
+
+  constexpr bool is_parallel(const PreparedLine &other) const {
+    for (size_t i = 1; i < Dim; ++i)
+      if (direction_sign(other.start, other.end, i) != 0)
+        return false;
+    return true;
+  }
+
+  constexpr bool intersects(const PreparedLine &other) const
+    requires(Dim == 2)
+  {
+    if (!bounds.overlaps(other.bounds) || is_parallel(other))
+      return false;
+    int o1 = direction_sign(start, other.start);
+    int o2 = direction_sign(start, other.end);
+    int o3 = other.direction_sign(other.start, start);
+    int o4 = other.direction_sign(other.start, end);
+    return o1 * o2 <= 0 && o3 * o4 <= 0;
+  }
+};
+
+} // namespace GeomCPP
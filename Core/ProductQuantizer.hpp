@@ -0,0 +1,360 @@
+#pragma once
+#include "./Parallel.hpp"
+#include "./Point.hpp"
+#include "./Simd_dispatch.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace GeomCPP {
+
+namespace detail {
+
+// Sub-quantizer slices are usually narrower than the dispatch threshold,
+// where the plain loop beats the indirect call.
+inline float row_squared_distance(const float *lhs, const float *rhs,
+                                  size_t dim) {
+  return dim < simd_dispatch_threshold
+             ? scalar_squared_distance(lhs, rhs, dim)
+             : simd_squared_distance(lhs, rhs, dim);
+}
+
+// Index of the row of centroids (count rows of width dim) closest to x.
+inline size_t nearest_centroid(const float *centroids, size_t count,
+                               size_t dim, const float *x) {
+  size_t best = 0;
+  float best_distance = std::numeric_limits<float>::infinity();
+  for (size_t c = 0; c < count; ++c) {
+    float distance = row_squared_distance(x, centroids + c * dim, dim);
+    if (distance < best_distance) {
+      best_distance = distance;
+      best = c;
+    }
+  }
+  return best;
+}
+
+// Lloyd's k-means over count rows of width dim, seeded with k distinct
+// random rows. An empty cluster takes over half of the largest one by
+// splitting its centroid with a small perturbation.
+inline std::vector<float> kmeans(const float *data, size_t count, size_t dim,
+                                 size_t k, size_t iterations,
+                                 std::uint64_t seed, size_t threads) {
+  if (count < k)
+    throw std::invalid_argument("k-means needs at least k training rows.");
+  std::vector<size_t> order(count);
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::mt19937_64 rng(seed);
+  std::shuffle(order.begin(), order.end(), rng);
+
+  std::vector<float> centroids(k * dim);
+  for (size_t c = 0; c < k; ++c)
+    std::copy_n(data + order[c] * dim, dim, centroids.begin() + c * dim);
+
+  std::vector<std::uint32_t> assignment(count);
+  std::vector<double> sums(k * dim);
+  std::vector<size_t> sizes(k);
+  for (size_t iteration = 0; iteration < iterations; ++iteration) {
+    parallel_for(
+        0, count, 256,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i)
+            assignment[i] = static_cast<std::uint32_t>(nearest_centroid(
+                centroids.data(), k, dim, data + i * dim));
+        },
+        threads);
+
+    std::fill(sums.begin(), sums.end(), 0.0);
+    std::fill(sizes.begin(), sizes.end(), size_t{0});
+    for (size_t i = 0; i < count; ++i) {
+      size_t c = assignment[i];
+      ++sizes[c];
+      for (size_t d = 0; d < dim; ++d)
+        sums[c * dim + d] += data[i * dim + d];
+    }
+    for (size_t c = 0; c < k; ++c)
+      if (sizes[c] != 0)
+        for (size_t d = 0; d < dim; ++d)
+          centroids[c * dim + d] =
+              static_cast<float>(sums[c * dim + d] / sizes[c]);
+
+    constexpr float nudge = 1.0f / 1024;
+    for (size_t c = 0; c < k; ++c) {
+      if (sizes[c] != 0)
+        continue;
+      size_t largest = static_cast<size_t>(
+          std::max_element(sizes.begin(), sizes.end()) - sizes.begin());
+      for (size_t d = 0; d < dim; ++d) {
+        float value = centroids[largest * dim + d];
+        float sign = d % 2 == 0 ? 1.0f : -1.0f;
+        centroids[c * dim + d] = value * (1 + sign * nudge);
+        centroids[largest * dim + d] = value * (1 - sign * nudge);
+      }
+      sizes[c] = sizes[largest] / 2;
+      sizes[largest] -= sizes[c];
+    }
+  }
+  return centroids;
+}
+
+// Asymmetric distance scan: out[i] = sum over j of table[j][codes[i][j]],
+// with table holding 256 entries per sub-quantizer and codes stored row by
+// row. Byte shuffles (pshufb) only index 16-entry tables, so 8-bit codes are
+// looked up with gathers instead: each gather fetches one entry from each of
+// 8 (or 16) consecutive sub-tables of the same code.
+GEOMCPP_ALWAYS_INLINE void adc_scan(const float *table,
+                                    const std::uint8_t *codes,
+                                    size_t code_size, size_t count,
+                                    float *out) {
+  for (size_t i = 0; i < count; ++i) {
+    const std::uint8_t *code = codes + i * code_size;
+    float sum = 0;
+    for (size_t j = 0; j < code_size; ++j)
+      sum += table[j * 256 + code[j]];
+    out[i] = sum;
+  }
+}
+
+using adc_scan_fn = void (*)(const float *, const std::uint8_t *, size_t,
+                             size_t, float *);
+
+inline void adc_scan_generic(const float *table, const std::uint8_t *codes,
+                             size_t code_size, size_t count, float *out) {
+  adc_scan(table, codes, code_size, count, out);
+}
+
+#if GEOMCPP_SIMD_X86
+__attribute__((target("avx2,fma"))) inline void
+adc_scan_avx2(const float *table, const std::uint8_t *codes,
+              size_t code_size, size_t count, float *out) {
+  const __m256i offsets =
+      _mm256_setr_epi32(0, 256, 512, 768, 1024, 1280, 1536, 1792);
+  for (size_t i = 0; i < count; ++i) {
+    const std::uint8_t *code = codes + i * code_size;
+    __m256 acc = _mm256_setzero_ps();
+    size_t j = 0;
+    for (; j + 8 <= code_size; j += 8) {
+      __m128i bytes =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(code + j));
+      __m256i slots = _mm256_add_epi32(_mm256_cvtepu8_epi32(bytes), offsets);
+      acc = _mm256_add_ps(acc,
+                          _mm256_i32gather_ps(table + j * 256, slots, 4));
+    }
+    float sum = avx2_horizontal_sum(acc);
+    for (; j < code_size; ++j)
+      sum += table[j * 256 + code[j]];
+    out[i] = sum;
+  }
+}
+
+__attribute__((target("avx512f"))) inline void
+adc_scan_avx512(const float *table, const std::uint8_t *codes,
+                size_t code_size, size_t count, float *out) {
+  // Masked, zero-filled intrinsic forms throughout: GCC 12 builds the plain
+  // ones on _mm512_undefined_*, which trips -Wmaybe-uninitialized.
+  const __m512i offsets = _mm512_setr_epi32(
+      0, 256, 512, 768, 1024, 1280, 1536, 1792, 2048, 2304, 2560, 2816,
+      3072, 3328, 3584, 3840);
+  const __m256i tail_offsets =
+      _mm256_setr_epi32(0, 256, 512, 768, 1024, 1280, 1536, 1792);
+  for (size_t i = 0; i < count; ++i) {
+    const std::uint8_t *code = codes + i * code_size;
+    __m512 acc = _mm512_setzero_ps();
+    size_t j = 0;
+    for (; j + 16 <= code_size; j += 16) {
+      __m128i bytes =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(code + j));
+      __m512i slots =
+          _mm512_add_epi32(_mm512_maskz_cvtepu8_epi32(0xFFFF, bytes), offsets);
+      acc = _mm512_add_ps(acc, _mm512_mask_i32gather_ps(
+                                   _mm512_setzero_ps(), 0xFFFF, slots,
+                                   table + j * 256, 4));
+    }
+    float sum = avx512_horizontal_sum(acc);
+    if (j + 8 <= code_size) {
+      __m128i bytes =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(code + j));
+      __m256i slots =
+          _mm256_add_epi32(_mm256_cvtepu8_epi32(bytes), tail_offsets);
+      sum += avx2_horizontal_sum(
+          _mm256_i32gather_ps(table + j * 256, slots, 4));
+      j += 8;
+    }
+    for (; j < code_size; ++j)
+      sum += table[j * 256 + code[j]];
+    out[i] = sum;
+  }
+}
+#endif // GEOMCPP_SIMD_X86
+
+inline adc_scan_fn active_adc_scan() {
+  static const adc_scan_fn kernel = [] {
+#if GEOMCPP_SIMD_X86
+    switch (active_simd_kernels().level) {
+    case simd_level::avx512:
+      return &adc_scan_avx512;
+    case simd_level::avx2:
+      return &adc_scan_avx2;
+    default:
+      break;
+    }
+#endif
+    return &adc_scan_generic;
+  }();
+  return kernel;
+}
+
+} // namespace detail
+
+// Product quantizer: a point is split into sub_quantizers equal slices and
+// each slice is replaced by the index of its nearest centroid in a 256-entry
+// codebook trained with k-means, giving one byte per slice. Distances from
+// an uncompressed query to coded points are approximated with a per-query
+// table of slice-to-centroid squared distances (asymmetric distance
+// computation). Codebooks and tables are float whatever T is.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class ProductQuantizer {
+public:
+  using point = Point<T, Dim>;
+  using code = std::uint8_t;
+
+  static constexpr size_t centroid_count = 256;
+
+private:
+  size_t slices;
+  size_t slice_dim;
+  std::vector<float> codebooks; // [slice][centroid][slice_dim]
+
+  static void to_float(const point &p, float *out) {
+    for (size_t d = 0; d < Dim; ++d)
+      out[d] = static_cast<float>(p.coordinate(d));
+  }
+
+  const float *centroid(size_t slice, size_t c) const {
+    return codebooks.data() + (slice * centroid_count + c) * slice_dim;
+  }
+
+  void check_trained() const {
+    if (!trained())
+      throw std::runtime_error("ProductQuantizer is not trained.");
+  }
+
+  void check_code_size(size_t size) const {
+    if (size != code_size())
+      throw std::invalid_argument("Code size does not match the quantizer.");
+  }
+
+public:
+  explicit ProductQuantizer(size_t sub_quantizers)
+      : slices(sub_quantizers),
+        slice_dim(sub_quantizers == 0 ? 0 : Dim / sub_quantizers) {
+    if (sub_quantizers == 0 || Dim % sub_quantizers != 0)
+      throw std::invalid_argument(
+          "Sub-quantizer count must divide the dimension.");
+  }
+
+  size_t sub_quantizers() const { return slices; }
+  size_t code_size() const { return slices; }
+  bool trained() const { return !codebooks.empty(); }
+
+  // Trains every codebook with k-means; needs at least 256 samples.
+  // threads == 0 uses every hardware thread.
+  void train(std::span<const point> samples, size_t iterations = 25,
+             std::uint64_t seed = 42, size_t threads = 0) {
+    if (samples.size() < centroid_count)
+      throw std::invalid_argument(
+          "ProductQuantizer needs at least 256 training samples.");
+    size_t count = samples.size();
+    std::vector<float> slice_data(count * slice_dim);
+    std::vector<float> trained_books(slices * centroid_count * slice_dim);
+    for (size_t s = 0; s < slices; ++s) {
+      for (size_t i = 0; i < count; ++i)
+        for (size_t d = 0; d < slice_dim; ++d)
+          slice_data[i * slice_dim + d] =
+              static_cast<float>(samples[i].coordinate(s * slice_dim + d));
+      std::vector<float> book =
+          detail::kmeans(slice_data.data(), count, slice_dim, centroid_count,
+                         iterations, seed + s, threads);
+      std::copy(book.begin(), book.end(),
+                trained_books.begin() + s * centroid_count * slice_dim);
+    }
+    codebooks = std::move(trained_books);
+  }
+
+  void encode(const point &p, std::span<code> out) const {
+    check_trained();
+    check_code_size(out.size());
+    std::array<float, Dim> x;
+    to_float(p, x.data());
+    for (size_t s = 0; s < slices; ++s)
+      out[s] = static_cast<code>(
+          detail::nearest_centroid(centroid(s, 0), centroid_count, slice_dim,
+                                   x.data() + s * slice_dim));
+  }
+
+  // Codes of every point, code_size() bytes each, in input order.
+  std::vector<code> encode(std::span<const point> points,
+                           size_t threads = 0) const {
+    check_trained();
+    std::vector<code> codes(points.size() * code_size());
+    parallel_for(
+        0, points.size(), 64,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i)
+            encode(points[i], std::span<code>(codes.data() + i * code_size(),
+                                              code_size()));
+        },
+        threads);
+    return codes;
+  }
+
+  // The point made of the centroids the code refers to.
+  point decode(std::span<const code> c) const {
+    check_trained();
+    check_code_size(c.size());
+    std::array<T, Dim> coordinates{};
+    for (size_t s = 0; s < slices; ++s) {
+      const float *values = centroid(s, c[s]);
+      for (size_t d = 0; d < slice_dim; ++d)
+        coordinates[s * slice_dim + d] = static_cast<T>(values[d]);
+    }
+    return point(coordinates);
+  }
+
+  // Per-query lookup table: entry [s * 256 + c] is the squared distance from
+  // slice s of the query to centroid c of codebook s.
+  std::vector<float> distance_table(const point &query) const {
+    check_trained();
+    std::array<float, Dim> x;
+    to_float(query, x.data());
+    std::vector<float> table(slices * centroid_count);
+    for (size_t s = 0; s < slices; ++s)
+      for (size_t c = 0; c < centroid_count; ++c)
+        table[s * centroid_count + c] = detail::row_squared_distance(
+            x.data() + s * slice_dim, centroid(s, c), slice_dim);
+    return table;
+  }
+
+  // Approximate squared distances from the query behind table to each code
+  // in codes (code_size() bytes each).
+  void asymmetric_distances(std::span<const float> table,
+                            std::span<const code> codes,
+                            std::span<float> out) const {
+    if (table.size() != slices * centroid_count)
+      throw std::invalid_argument("Distance table does not match quantizer.");
+    if (codes.size() != out.size() * code_size())
+      throw std::invalid_argument("Batch inputs must have the same size.");
+    detail::active_adc_scan()(table.data(), codes.data(), code_size(),
+                              out.size(), out.data());
+  }
+};
+
+} // namespace GeomCPP
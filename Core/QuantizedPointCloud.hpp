@@ -0,0 +1,198 @@
+#pragma once
+#include "./PointCloud.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace GeomCPP {
+
+template <typename Code>
+concept quantization_code =
+    std::is_same_v<Code, std::int16_t> || std::is_same_v<Code, std::int32_t>;
+
+// Lossy, compact point storage: points are grouped into fixed-size blocks and
+// each coordinate is stored as an integer offset from the block's origin in
+// units of the block's scale. Batched kernels decode on the fly so the full
+// precision coordinates never have to be materialised.
+template <typename T, size_t Dim, quantization_code Code = std::int16_t>
+  requires std::is_floating_point_v<T>
+class QuantizedPointCloud {
+public:
+  using point = Point<T, Dim>;
+  static constexpr size_t block_size = 1024;
+
+private:
+  struct block_header {
+    std::array<T, Dim> origin;
+    T scale;
+  };
+
+  std::array<std::vector<Code, aligned_allocator<Code>>, Dim> codes;
+  std::vector<block_header> blocks;
+  size_t count = 0;
+  T max_axis_error = 0;
+
+  void check_output(size_t size) const {
+    if (size < count)
+      throw std::invalid_argument("Output buffer is smaller than the cloud.");
+  }
+
+  // Calls body(block, begin, end) for every block of the cloud.
+  template <typename Body> void for_each_block(Body &&body) const {
+    for (size_t b = 0; b < blocks.size(); ++b)
+      body(blocks[b], b * block_size, std::min((b + 1) * block_size, count));
+  }
+
+public:
+  QuantizedPointCloud() = default;
+
+  explicit QuantizedPointCloud(const PointCloud<T, Dim> &cloud)
+      : count(cloud.size()) {
+    // Codes are computed and clamped in double: the largest int32 code is
+    // not representable in float, where it would round up and overflow.
+    constexpr double max_code = std::numeric_limits<Code>::max();
+
+    for (auto &axis : codes)
+      axis.resize(count);
+    blocks.reserve((count + block_size - 1) / block_size);
+
+    for (size_t begin = 0; begin < count; begin += block_size) {
+      const size_t end = std::min(begin + block_size, count);
+      block_header header{};
+
+      T half_extent = 0;
+      T magnitude = 0; // largest |coordinate| in the block
+      for (size_t d = 0; d < Dim; ++d) {
+        const T *values = cloud.axis_data(d);
+        auto [low, high] = std::minmax_element(values + begin, values + end);
+        header.origin[d] = *low + (*high - *low) / 2;
+        half_extent = std::max(half_extent, (*high - *low) / 2);
+        magnitude = std::max({magnitude, std::abs(*low), std::abs(*high)});
+      }
+      header.scale =
+          half_extent > 0 ? static_cast<T>(half_extent / max_code) : T{1};
+
+      // Half a quantization step, plus the rounding of origin + code * scale
+      // in T (and of the origin and scale themselves), which dominates once
+      // the step drops below the coordinates' ulp.
+      constexpr T epsilon = std::numeric_limits<T>::epsilon();
+      T block_error = (half_extent > 0 ? header.scale / 2 : T{0}) +
+                      2 * epsilon * (magnitude + half_extent);
+      max_axis_error = std::max(max_axis_error, block_error);
+
+      for (size_t d = 0; d < Dim; ++d) {
+        const T *values = cloud.axis_data(d);
+        Code *out = codes[d].data();
+        const double inverse_scale = 1.0 / header.scale;
+        for (size_t i = begin; i < end; ++i) {
+          double offset = std::round(
+              (static_cast<double>(values[i]) - header.origin[d]) *
+              inverse_scale);
+          out[i] = static_cast<Code>(std::clamp(offset, -max_code, max_code));
+        }
+      }
+      blocks.push_back(header);
+    }
+  }
+
+  explicit QuantizedPointCloud(const std::vector<point> &points)
+      : QuantizedPointCloud(PointCloud<T, Dim>(points)) {}
+
+  [[nodiscard]] inline static constexpr size_t get_dimensions() { return Dim; }
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  // Bytes held by codes and block headers, for comparing against PointCloud.
+  size_t storage_bytes() const {
+    return count * Dim * sizeof(Code) + blocks.size() * sizeof(block_header);
+  }
+
+  // Largest per-axis reconstruction error of any stored coordinate.
+  T axis_error_bound() const { return max_axis_error; }
+
+  // Bound on the Euclidean distance between a decoded point and its original,
+  // derived from axis_error_bound(). It covers decoding only: the results of
+  // distance() and the batched kernels also carry the rounding error of
+  // their own arithmetic against the query.
+  T error_bound() const {
+    return axis_error_bound() * std::sqrt(static_cast<T>(Dim));
+  }
+
+  point get_point(size_t index) const {
+    if (index >= count)
+      throw std::out_of_range("Point cloud index out of range");
+
+    const block_header &header = blocks[index / block_size];
+    std::array<T, Dim> coords;
+    for (size_t d = 0; d < Dim; ++d)
+      coords[d] = header.origin[d] + codes[d][index] * header.scale;
+    return point(coords);
+  }
+
+  point operator[](size_t index) const { return get_point(index); }
+
+  PointCloud<T, Dim> decode() const {
+    PointCloud<T, Dim> cloud(count);
+    for_each_block([&](const block_header &header, size_t begin, size_t end) {
+      for (size_t d = 0; d < Dim; ++d) {
+        const Code *in = codes[d].data();
+        T *out = cloud.axis_data(d);
+        for (size_t i = begin; i < end; ++i)
+          out[i] = header.origin[d] + in[i] * header.scale;
+      }
+    });
+    return cloud;
+  }
+
+  void squared_distance(const point &query, std::span<T> out) const {
+    check_output(out.size());
+    std::fill(out.begin(), out.begin() + count, T{0});
+
+    for_each_block([&](const block_header &header, size_t begin, size_t end) {
+      for (size_t d = 0; d < Dim; ++d) {
+        const Code *in = codes[d].data();
+        const T base = header.origin[d] - query[d];
+        const T scale = header.scale;
+        for (size_t i = begin; i < end; ++i) {
+          T diff = base + in[i] * scale;
+          out[i] += diff * diff;
+        }
+      }
+    });
+  }
+
+  void distance(const point &query, std::span<T> out) const {
+    squared_distance(query, out);
+    for (size_t i = 0; i < count; ++i)
+      out[i] = std::sqrt(out[i]);
+  }
+
+  void dot(const point &query, std::span<T> out) const {
+    check_output(out.size());
+
+    for_each_block([&](const block_header &header, size_t begin, size_t end) {
+      // origin . query is shared by the whole block, so only the scaled
+      // integer offsets are touched per point.
+      T base = 0;
+      for (size_t d = 0; d < Dim; ++d)
+        base += header.origin[d] * query[d];
+      for (size_t i = begin; i < end; ++i)
+        out[i] = base;
+
+      for (size_t d = 0; d < Dim; ++d) {
+        const Code *in = codes[d].data();
+        const T weight = header.scale * query[d];
+        for (size_t i = begin; i < end; ++i)
+          out[i] += in[i] * weight;
+      }
+    });
+  }
+};
+
+} // namespace GeomCPP
@@ -0,0 +1,450 @@
+#pragma once
+#include "./BoundingBox.hpp"
+#include "./Line.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GeomCPP {
+
+namespace detail {
+
+// Squared distance from p to the closest point of segment ab.
+template <typename Real, typename T>
+constexpr Real segment_squared_distance(const Point<T, 2> &p,
+                                        const Line<T, 2> &segment) {
+  const Point<T, 2> a = segment.get_start(), b = segment.get_end();
+  Real dx = static_cast<Real>(b[0]) - static_cast<Real>(a[0]);
+  Real dy = static_cast<Real>(b[1]) - static_cast<Real>(a[1]);
+  Real px = static_cast<Real>(p[0]) - static_cast<Real>(a[0]);
+  Real py = static_cast<Real>(p[1]) - static_cast<Real>(a[1]);
+
+  Real t = std::clamp((px * dx + py * dy) / (dx * dx + dy * dy), Real{0},
+                      Real{1});
+  Real ex = px - t * dx, ey = py - t * dy;
+  return ex * ex + ey * ey;
+}
+
+} // namespace detail
+
+// R-tree over the bounding boxes of 2D segments. Nodes live in one vector
+// and hold their children's boxes inline, so a traversal touches one
+// contiguous block per node. Built with Sort-Tile-Recursive packing; insert
+// splits overflowing nodes along the axis with the widest spread of child
+// centres, erase dissolves underfull nodes and reinserts their segments.
+template <typename T>
+  requires point_numeric<T>
+class RTree {
+public:
+  using point = Point<T, 2>;
+  using line = Line<T, 2>;
+  using box = BoundingBox<T, 2>;
+  using real = typename box::real;
+
+  static constexpr size_t max_entries = 16;
+  static constexpr size_t min_entries = max_entries / 4;
+
+  struct nearest_segment {
+    size_t id;
+    real squared_distance;
+  };
+
+private:
+  using index = std::uint32_t;
+
+  // Leaves reference segment ids, internal nodes reference nodes.
+  struct node {
+    std::array<box, max_entries> bounds;
+    std::array<index, max_entries> children;
+    index count = 0;
+    bool leaf = true;
+  };
+
+  struct entry {
+    box bounds;
+    index child;
+  };
+
+  std::vector<node> nodes;
+  std::vector<index> free_nodes;
+  index root = 0;
+
+  std::vector<line> segments; // by id; erased ids are never reused
+  std::vector<bool> live;
+  size_t live_count = 0;
+
+  index allocate_node(bool leaf) {
+    if (!free_nodes.empty()) {
+      index id = free_nodes.back();
+      free_nodes.pop_back();
+      nodes[id] = node{};
+      nodes[id].leaf = leaf;
+      return id;
+    }
+    nodes.emplace_back();
+    nodes.back().leaf = leaf;
+    return static_cast<index>(nodes.size() - 1);
+  }
+
+  box node_bounds(index id) const {
+    const node &n = nodes[id];
+    box result = n.bounds[0];
+    for (index i = 1; i < n.count; ++i)
+      result.expand(n.bounds[i]);
+    return result;
+  }
+
+  static void append(node &n, const entry &e) {
+    n.bounds[n.count] = e.bounds;
+    n.children[n.count] = e.child;
+    ++n.count;
+  }
+
+  // Sort-Tile-Recursive: order by x-centre, cut into vertical slices of
+  // about sqrt(#nodes) nodes each, order each slice by y-centre and pack.
+  std::vector<entry> pack_level(std::vector<entry> items, bool leaf) {
+    auto by_centre = [](size_t d) {
+      return [d](const entry &a, const entry &b) {
+        return a.bounds.center(d) < b.bounds.center(d);
+      };
+    };
+    size_t node_count = (items.size() + max_entries - 1) / max_entries;
+    size_t slices = static_cast<size_t>(
+        std::ceil(std::sqrt(static_cast<double>(node_count))));
+    size_t slice_size = slices * max_entries;
+
+    std::sort(items.begin(), items.end(), by_centre(0));
+    std::vector<entry> parents;
+    for (size_t s = 0; s < items.size(); s += slice_size) {
+      auto slice_end = items.begin() + std::min(s + slice_size, items.size());
+      std::sort(items.begin() + s, slice_end, by_centre(1));
+      for (auto it = items.begin() + s; it < slice_end; it += max_entries) {
+        index id = allocate_node(leaf);
+        for (auto e = it; e < std::min(it + max_entries, slice_end); ++e)
+          append(nodes[id], *e);
+        parents.push_back({node_bounds(id), id});
+      }
+    }
+    return parents;
+  }
+
+  // Splits an overflowing set of entries in half along the axis whose child
+  // centres are spread widest.
+  static std::pair<std::vector<entry>, std::vector<entry>>
+  split(std::vector<entry> entries) {
+    std::array<real, 2> low, high;
+    for (size_t d = 0; d < 2; ++d) {
+      auto [lo, hi] = std::minmax_element(
+          entries.begin(), entries.end(),
+          [d](const entry &a, const entry &b) {
+            return a.bounds.center(d) < b.bounds.center(d);
+          });
+      low[d] = lo->bounds.center(d);
+      high[d] = hi->bounds.center(d);
+    }
+    size_t axis = high[1] - low[1] > high[0] - low[0] ? 1 : 0;
+    std::sort(entries.begin(), entries.end(),
+              [axis](const entry &a, const entry &b) {
+                return a.bounds.center(axis) < b.bounds.center(axis);
+              });
+
+    auto middle = entries.begin() + entries.size() / 2;
+    return {std::vector<entry>(entries.begin(), middle),
+            std::vector<entry>(middle, entries.end())};
+  }
+
+  // Adds e to the node at path.back(), splitting upwards as needed.
+  void insert_along(std::vector<index> &path, entry e) {
+    for (size_t level = path.size(); level-- > 0;) {
+      index current = path[level];
+      if (nodes[current].count < max_entries) {
+        append(nodes[current], e);
+        for (size_t up = level; up-- > 0;)
+          refresh_child(path[up], path[up + 1]);
+        return;
+      }
+
+      std::vector<entry> overflow;
+      for (index i = 0; i < nodes[current].count; ++i)
+        overflow.push_back(
+            {nodes[current].bounds[i], nodes[current].children[i]});
+      overflow.push_back(e);
+      auto [first, second] = split(std::move(overflow));
+
+      bool leaf = nodes[current].leaf;
+      index sibling = allocate_node(leaf);
+      nodes[current].count = 0;
+      for (const entry &item : first)
+        append(nodes[current], item);
+      for (const entry &item : second)
+        append(nodes[sibling], item);
+
+      if (level == 0) {
+        index new_root = allocate_node(false);
+        append(nodes[new_root], {node_bounds(current), current});
+        append(nodes[new_root], {node_bounds(sibling), sibling});
+        root = new_root;
+        return;
+      }
+      refresh_child(path[level - 1], current);
+      e = {node_bounds(sibling), sibling};
+    }
+  }
+
+  void refresh_child(index parent, index child) {
+    node &n = nodes[parent];
+    for (index i = 0; i < n.count; ++i)
+      if (n.children[i] == child) {
+        n.bounds[i] = node_bounds(child);
+        return;
+      }
+  }
+
+  void insert_id(index id) {
+    box bounds = box::of(segments[id]);
+    std::vector<index> path{root};
+    while (!nodes[path.back()].leaf) {
+      const node &n = nodes[path.back()];
+      index best = 0;
+      real best_growth = std::numeric_limits<real>::infinity();
+      real best_measure = best_growth;
+      for (index i = 0; i < n.count; ++i) {
+        real measure = n.bounds[i].measure();
+        real growth = n.bounds[i].merged(bounds).measure() - measure;
+        if (growth < best_growth ||
+            (growth == best_growth && measure < best_measure)) {
+          best = i;
+          best_growth = growth;
+          best_measure = measure;
+        }
+      }
+      path.push_back(n.children[best]);
+    }
+    insert_along(path, {bounds, id});
+  }
+
+  bool find_leaf(index current, index id, const box &bounds,
+                 std::vector<index> &path) const {
+    path.push_back(current);
+    const node &n = nodes[current];
+    for (index i = 0; i < n.count; ++i) {
+      if (n.leaf) {
+        if (n.children[i] == id)
+          return true;
+      } else if (n.bounds[i].contains(bounds) &&
+                 find_leaf(n.children[i], id, bounds, path)) {
+        return true;
+      }
+    }
+    path.pop_back();
+    return false;
+  }
+
+  void collect_segments(index current, std::vector<index> &out) {
+    node &n = nodes[current];
+    for (index i = 0; i < n.count; ++i) {
+      if (n.leaf)
+        out.push_back(n.children[i]);
+      else
+        collect_segments(n.children[i], out);
+    }
+    free_nodes.push_back(current);
+  }
+
+  static void remove_slot(node &n, index slot) {
+    --n.count;
+    n.bounds[slot] = n.bounds[n.count];
+    n.children[slot] = n.children[n.count];
+  }
+
+  // Depth-first walk over every live segment whose box passes accept.
+  template <typename Accept, typename Visit>
+  void walk(Accept accept, Visit visit) const {
+    if (live_count == 0)
+      return;
+    std::vector<index> stack{root};
+    while (!stack.empty()) {
+      const node &n = nodes[stack.back()];
+      stack.pop_back();
+      for (index i = 0; i < n.count; ++i) {
+        if (!accept(n.bounds[i]))
+          continue;
+        if (n.leaf)
+          visit(static_cast<size_t>(n.children[i]));
+        else
+          stack.push_back(n.children[i]);
+      }
+    }
+  }
+
+public:
+  RTree() { root = allocate_node(true); }
+
+  explicit RTree(const std::vector<line> &lines) : segments(lines) {
+    if (lines.size() >= std::numeric_limits<index>::max())
+      throw std::length_error("Too many segments for RTree");
+    live.assign(lines.size(), true);
+    live_count = lines.size();
+
+    std::vector<entry> items;
+    items.reserve(lines.size());
+    for (size_t i = 0; i < lines.size(); ++i)
+      items.push_back({box::of(lines[i]), static_cast<index>(i)});
+
+    if (items.empty()) {
+      root = allocate_node(true);
+      return;
+    }
+    bool leaf = true;
+    do {
+      items = pack_level(std::move(items), leaf);
+      leaf = false;
+    } while (items.size() > 1);
+    root = items.front().child;
+  }
+
+  size_t size() const { return live_count; }
+  bool empty() const { return live_count == 0; }
+
+  const line &segment(size_t id) const { return segments.at(id); }
+
+  // Returns the id of the new segment.
+  size_t insert(const line &segment) {
+    if (segments.size() >= std::numeric_limits<index>::max())
+      throw std::length_error("Too many segments for RTree");
+    segments.push_back(segment);
+    live.push_back(true);
+    ++live_count;
+    insert_id(static_cast<index>(segments.size() - 1));
+    return segments.size() - 1;
+  }
+
+  // False if id is unknown or already erased.
+  bool erase(size_t id) {
+    if (id >= segments.size() || !live[id])
+      return false;
+
+    std::vector<index> path;
+    find_leaf(root, static_cast<index>(id), box::of(segments[id]), path);
+    node &leaf = nodes[path.back()];
+    for (index i = 0; i < leaf.count; ++i)
+      if (leaf.children[i] == id) {
+        remove_slot(leaf, i);
+        break;
+      }
+    live[id] = false;
+    --live_count;
+
+    // Condense: dissolve underfull nodes below the root, tighten the rest.
+    std::vector<index> orphans;
+    for (size_t level = path.size() - 1; level > 0; --level) {
+      index current = path[level];
+      node &parent = nodes[path[level - 1]];
+      for (index i = 0; i < parent.count; ++i) {
+        if (parent.children[i] != current)
+          continue;
+        if (nodes[current].count < min_entries) {
+          remove_slot(parent, i);
+          collect_segments(current, orphans);
+        } else {
+          parent.bounds[i] = node_bounds(current);
+        }
+        break;
+      }
+    }
+
+    while (!nodes[root].leaf && nodes[root].count == 1) {
+      free_nodes.push_back(root);
+      root = nodes[root].children[0];
+    }
+    if (!nodes[root].leaf && nodes[root].count == 0)
+      nodes[root].leaf = true;
+
+    for (index orphan : orphans)
+      insert_id(orphan);
+    return true;
+  }
+
+  // Ids of the segments that touch the closed window.
+  std::vector<size_t> window(const box &area) const {
+    std::vector<size_t> result;
+    walk([&](const box &b) { return b.overlaps(area); },
+         [&](size_t id) {
+           if (area.intersects(segments[id]))
+             result.push_back(id);
+         });
+    return result;
+  }
+
+  std::vector<size_t> window(const point &corner1,
+                             const point &corner2) const {
+    return window(box::of(corner1, corner2));
+  }
+
+  // Ids of the segments whose bounding box overlaps the query's; a superset
+  // of the segments it intersects.
+  std::vector<size_t> intersection_candidates(const line &query) const {
+    std::vector<size_t> result;
+    box area = box::of(query);
+    walk([&](const box &b) { return b.overlaps(area); },
+         [&](size_t id) { result.push_back(id); });
+    return result;
+  }
+
+  // Candidates filtered with Line::intersects.
+  std::vector<size_t> intersecting(const line &query) const {
+    std::vector<size_t> result;
+    for (size_t id : intersection_candidates(query))
+      if (query.intersects(segments[id]))
+        result.push_back(id);
+    return result;
+  }
+
+  // The k segments closest to p, nearest first (best-first search).
+  std::vector<nearest_segment> nearest(const point &p, size_t k = 1) const {
+    std::vector<nearest_segment> result;
+    if (k == 0 || empty())
+      return result;
+
+    struct candidate {
+      real squared_distance;
+      index id;
+      bool is_segment;
+      bool operator>(const candidate &other) const {
+        return squared_distance > other.squared_distance;
+      }
+    };
+    std::priority_queue<candidate, std::vector<candidate>, std::greater<>>
+        queue;
+    queue.push({0, root, false});
+
+    while (!queue.empty() && result.size() < k) {
+      candidate top = queue.top();
+      queue.pop();
+      if (top.is_segment) {
+        result.push_back({top.id, top.squared_distance});
+        continue;
+      }
+      const node &n = nodes[top.id];
+      for (index i = 0; i < n.count; ++i) {
+        if (n.leaf)
+          queue.push({detail::segment_squared_distance<real>(
+                          p, segments[n.children[i]]),
+                      n.children[i], true});
+        else
+          queue.push({n.bounds[i].squared_distance(p), n.children[i], false});
+      }
+    }
+    return result;
+  }
+};
+
+} // namespace GeomCPP
@@ -0,0 +1,198 @@
+#pragma once
+#include "./Parallel.hpp"
+#include "./PointCloud.hpp"
+#include <array>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace GeomCPP {
+
+namespace detail {
+
+// Reflects points [begin, end) of coords in place across n . x + c = 0.
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+GEOMCPP_ALWAYS_INLINE void
+reflect_coordinates(Coordinates coords, size_t begin, size_t end,
+                    const std::array<Real, Dim> &hyperplane_normal,
+                    const std::array<Real, Dim> &hyperplane_scaled,
+                    Real offset) {
+  // Local copies: when T == Real the stores could otherwise alias them.
+  const std::array<Real, Dim> normal = hyperplane_normal;
+  const std::array<Real, Dim> scaled_normal = hyperplane_scaled;
+  // The axis loops are unrolled so the vectorizer works across points.
+  for (size_t i = begin; i < end; ++i) {
+    Real side = offset;
+#pragma GCC unroll 4
+    for (size_t d = 0; d < Dim; ++d)
+      side += normal[d] * static_cast<Real>(coords(i, d));
+#pragma GCC unroll 4
+    for (size_t d = 0; d < Dim; ++d)
+      coords(i, d) = static_cast<T>(static_cast<Real>(coords(i, d)) -
+                                    side * scaled_normal[d]);
+  }
+}
+
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+using reflect_coordinates_fn = void (*)(Coordinates, size_t, size_t,
+                                        const std::array<Real, Dim> &,
+                                        const std::array<Real, Dim> &, Real);
+
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+void reflect_coordinates_generic(Coordinates coords, size_t begin, size_t end,
+                                 const std::array<Real, Dim> &normal,
+                                 const std::array<Real, Dim> &scaled_normal,
+                                 Real offset) {
+  reflect_coordinates<T, Dim, Real>(coords, begin, end, normal, scaled_normal,
+                                    offset);
+}
+
+#if GEOMCPP_SIMD_X86
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+__attribute__((target("avx2"))) void
+reflect_coordinates_avx2(Coordinates coords, size_t begin, size_t end,
+                         const std::array<Real, Dim> &normal,
+                         const std::array<Real, Dim> &scaled_normal,
+                         Real offset) {
+  reflect_coordinates<T, Dim, Real>(coords, begin, end, normal, scaled_normal,
+                                    offset);
+}
+
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+__attribute__((target("avx512f"))) void
+reflect_coordinates_avx512(Coordinates coords, size_t begin, size_t end,
+                           const std::array<Real, Dim> &normal,
+                           const std::array<Real, Dim> &scaled_normal,
+                           Real offset) {
+  reflect_coordinates<T, Dim, Real>(coords, begin, end, normal, scaled_normal,
+                                    offset);
+}
+#endif // GEOMCPP_SIMD_X86
+
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+reflect_coordinates_fn<T, Dim, Real, Coordinates> active_reflect_coordinates() {
+  static const reflect_coordinates_fn<T, Dim, Real, Coordinates> kernel = [] {
+#if GEOMCPP_SIMD_X86
+    switch (active_simd_kernels().level) {
+    case simd_level::avx512:
+      return &reflect_coordinates_avx512<T, Dim, Real, Coordinates>;
+    case simd_level::avx2:
+      return &reflect_coordinates_avx2<T, Dim, Real, Coordinates>;
+    default:
+      break;
+    }
+#endif
+    return &reflect_coordinates_generic<T, Dim, Real, Coordinates>;
+  }();
+  return kernel;
+}
+
+} // namespace detail
+
+// Reflection across a fixed line (2D) or plane (3D). The hyperplane
+// n . x + c = 0 and the 2 / |n|^2 factor are computed once, so applying it
+// costs one dot product and one scaled subtraction per point. Uses the same
+// conventions as Point::reflect.
+template <typename T, size_t Dim>
+  requires point_numeric<T> && (Dim == 2 || Dim == 3)
+class Reflection {
+public:
+  using point = Point<T, Dim>;
+  using real = std::conditional_t<std::is_floating_point_v<accumulate_t<T>>,
+                                  accumulate_t<T>, double>;
+
+  // Points handed to one thread at a time by the batched overloads.
+  static constexpr size_t parallel_grain = 16384;
+
+private:
+  std::array<real, Dim> normal;
+  std::array<real, Dim> scaled_normal; // 2 n / |n|^2
+  real offset;
+
+  constexpr void prepare(const std::array<real, Dim> &hyperplane_normal,
+                         real hyperplane_offset) {
+    real norm_squared = 0;
+    for (size_t d = 0; d < Dim; ++d)
+      norm_squared += hyperplane_normal[d] * hyperplane_normal[d];
+    if (norm_squared == 0)
+      throw std::invalid_argument("Reflection hyperplane is degenerate.");
+
+    normal = hyperplane_normal;
+    offset = hyperplane_offset;
+    for (size_t d = 0; d < Dim; ++d)
+      scaled_normal[d] = 2 * normal[d] / norm_squared;
+  }
+
+public:
+  constexpr Reflection(const point &line_point1, const point &line_point2)
+    requires(Dim == 2)
+      : normal{}, scaled_normal{}, offset{} {
+    real x1 = static_cast<real>(line_point1[0]);
+    real y1 = static_cast<real>(line_point1[1]);
+    real x2 = static_cast<real>(line_point2[0]);
+    real y2 = static_cast<real>(line_point2[1]);
+
+    real a = y2 - y1; // dy
+    real b = x1 - x2; // -dx
+    prepare({a, b}, -(a * x1 + b * y1));
+  }
+
+  constexpr Reflection(const point &plane_point, const point &plane_normal)
+    requires(Dim == 3)
+      : normal{}, scaled_normal{}, offset{} {
+    std::array<real, Dim> n;
+    real d = 0;
+    for (size_t i = 0; i < Dim; ++i) {
+      n[i] = static_cast<real>(plane_normal[i]);
+      d -= n[i] * static_cast<real>(plane_point[i]);
+    }
+    prepare(n, d);
+  }
+
+  // Hyperplane in the form n . x + c = 0.
+  constexpr const std::array<real, Dim> &get_normal() const { return normal; }
+  constexpr real get_offset() const { return offset; }
+
+  constexpr point apply(const point &p) const {
+    real side = offset;
+    for (size_t d = 0; d < Dim; ++d)
+      side += normal[d] * static_cast<real>(p[d]);
+
+    std::array<T, Dim> coords;
+    for (size_t d = 0; d < Dim; ++d)
+      coords[d] = static_cast<T>(static_cast<real>(p[d]) -
+                                 side * scaled_normal[d]);
+    return point(coords);
+  }
+
+  constexpr point operator()(const point &p) const { return apply(p); }
+
+  // In-place batched application; threads == 0 uses every hardware thread.
+  void apply(std::span<point> points, size_t threads = 1) const {
+    apply_batch(detail::point_coordinates<T, Dim>{points.data()},
+                points.size(), threads);
+  }
+
+  void apply(PointCloud<T, Dim> &cloud, size_t threads = 1) const {
+    apply_batch(detail::coordinates_of(cloud), cloud.size(), threads);
+  }
+
+private:
+  template <typename Coordinates>
+  void apply_batch(Coordinates coords, size_t count, size_t threads) const {
+    detail::reflect_coordinates_fn<T, Dim, real, Coordinates> kernel;
+    if constexpr (simd_element<T>)
+      kernel = detail::active_reflect_coordinates<T, Dim, real, Coordinates>();
+    else
+      kernel = &detail::reflect_coordinates_generic<T, Dim, real, Coordinates>;
+
+    parallel_for(
+        0, count, parallel_grain,
+        [&](size_t begin, size_t end) {
+          kernel(coords, begin, end, normal, scaled_normal, offset);
+        },
+        threads);
+  }
+};
+
+} // namespace GeomCPP
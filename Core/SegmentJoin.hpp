@@ -0,0 +1,207 @@
+#pragma once
+#include "./BoundingBox.hpp"
+#include "./Parallel.hpp"
+#include "./SweepLine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace GeomCPP {
+
+// Parallel all-pairs segment intersection join. Space is cut into a grid of
+// tiles over the bounding box of the input, every segment is registered in
+// each tile its bounding box overlaps, and each tile runs its own SweepLine
+// on a pool thread. A pair seen in several tiles is kept only by the tile
+// holding its reference point, the lower-left corner of the overlap of the
+// two bounding boxes. That corner is made of input coordinates and lies in
+// both boxes, so exactly one tile shared by the pair owns it.
+namespace detail {
+
+// Segments per tile aimed for when the tile count is chosen automatically.
+inline constexpr size_t join_tile_target = 1024;
+inline constexpr size_t join_max_tiles_per_axis = 1024;
+
+template <typename T> class segment_tiling {
+public:
+  using line = Line<T, 2>;
+  using box = BoundingBox<T, 2>;
+  using real = typename box::real;
+  using index = std::uint32_t;
+
+  std::vector<box> bounds;
+  size_t columns = 1, rows = 1;
+  std::vector<size_t> offsets; // tiles + 1 entries
+  std::vector<index> items;
+
+private:
+  real origin_x = 0, origin_y = 0, width = 1, height = 1;
+
+  static size_t cell_of(T value, real origin, real size, size_t count) {
+    real cell = std::floor((static_cast<real>(value) - origin) / size);
+    if (!(cell > 0))
+      return 0;
+    return std::min(count - 1, static_cast<size_t>(cell));
+  }
+
+public:
+  segment_tiling(std::span<const line> segments, size_t tiles_per_axis,
+                 size_t threads) {
+    if (segments.size() >= std::numeric_limits<index>::max())
+      throw std::length_error("Too many segments for segment join");
+    bounds.reserve(segments.size());
+    for (const line &s : segments)
+      bounds.push_back(box::of(s));
+    if (bounds.empty()) {
+      offsets.assign(2, 0);
+      return;
+    }
+
+    box extent = bounds[0];
+    for (const box &b : bounds)
+      extent.expand(b);
+    if (tiles_per_axis == 0)
+      tiles_per_axis = static_cast<size_t>(std::ceil(std::sqrt(
+          static_cast<double>(segments.size()) / join_tile_target)));
+    tiles_per_axis =
+        std::clamp<size_t>(tiles_per_axis, 1, join_max_tiles_per_axis);
+    columns = rows = tiles_per_axis;
+    origin_x = static_cast<real>(extent.lower[0]);
+    origin_y = static_cast<real>(extent.lower[1]);
+    real span_x = static_cast<real>(extent.upper[0]) - origin_x;
+    real span_y = static_cast<real>(extent.upper[1]) - origin_y;
+    width = span_x > 0 ? span_x / columns : 1;
+    height = span_y > 0 ? span_y / rows : 1;
+
+    size_t tiles = columns * rows;
+    std::vector<std::atomic<size_t>> counts(tiles);
+    auto for_tiles = [&](size_t i, auto &&visit) {
+      const box &b = bounds[i];
+      size_t last_column = column_of(b.upper[0]);
+      size_t last_row = row_of(b.upper[1]);
+      for (size_t row = row_of(b.lower[1]); row <= last_row; ++row)
+        for (size_t column = column_of(b.lower[0]); column <= last_column;
+             ++column)
+          visit(row * columns + column);
+    };
+    parallel_for(
+        0, bounds.size(), 4096,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i)
+            for_tiles(i, [&](size_t t) {
+              counts[t].fetch_add(1, std::memory_order_relaxed);
+            });
+        },
+        threads);
+
+    offsets.resize(tiles + 1);
+    size_t running = 0;
+    for (size_t t = 0; t < tiles; ++t) {
+      offsets[t] = running;
+      running += counts[t].load(std::memory_order_relaxed);
+      counts[t].store(offsets[t], std::memory_order_relaxed);
+    }
+    offsets[tiles] = running;
+    items.resize(running);
+    parallel_for(
+        0, bounds.size(), 4096,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i)
+            for_tiles(i, [&](size_t t) {
+              size_t slot = counts[t].fetch_add(1, std::memory_order_relaxed);
+              items[slot] = static_cast<index>(i);
+            });
+        },
+        threads);
+  }
+
+  size_t tile_count() const { return columns * rows; }
+
+  size_t column_of(T x) const { return cell_of(x, origin_x, width, columns); }
+  size_t row_of(T y) const { return cell_of(y, origin_y, height, rows); }
+
+  // Tile owning the pair (a, b) of overlapping boxes.
+  size_t reference_tile(index a, index b) const {
+    T x = std::max(bounds[a].lower[0], bounds[b].lower[0]);
+    T y = std::max(bounds[a].lower[1], bounds[b].lower[1]);
+    return row_of(y) * columns + column_of(x);
+  }
+
+  // Calls visit(i, j) for the pairs, in input positions, that tile owns.
+  template <typename Visit>
+  void join_tile(std::span<const line> segments, size_t tile,
+                 Visit &&visit) const {
+    size_t first = offsets[tile], last = offsets[tile + 1];
+    if (last - first < 2)
+      return;
+    std::vector<line> local;
+    local.reserve(last - first);
+    for (size_t k = first; k < last; ++k)
+      local.push_back(segments[items[k]]);
+    SweepLine<T> sweep(local);
+    sweep.for_each_pair([&](size_t a, size_t b) {
+      index i = items[first + a], j = items[first + b];
+      if (reference_tile(i, j) == tile)
+        visit(std::min(i, j), std::max(i, j));
+    });
+  }
+};
+
+} // namespace detail
+
+// Pairs (i, j), i < j, of segments for which Line::intersects holds, sorted.
+// tiles_per_axis == 0 picks about join_tile_target segments per tile;
+// threads == 0 uses every hardware thread.
+template <typename T>
+  requires point_numeric<T>
+std::vector<std::pair<size_t, size_t>>
+intersecting_pairs(std::span<const Line<T, 2>> segments, size_t threads = 0,
+                   size_t tiles_per_axis = 0) {
+  detail::segment_tiling<T> tiling(segments, tiles_per_axis, threads);
+  std::vector<std::pair<size_t, size_t>> pairs;
+  std::mutex pairs_mutex;
+  parallel_for(
+      0, tiling.tile_count(), 1,
+      [&](size_t begin, size_t end) {
+        std::vector<std::pair<size_t, size_t>> local;
+        for (size_t t = begin; t < end; ++t)
+          tiling.join_tile(segments, t, [&](size_t i, size_t j) {
+            local.emplace_back(i, j);
+          });
+        std::lock_guard<std::mutex> lock(pairs_mutex);
+        pairs.insert(pairs.end(), local.begin(), local.end());
+      },
+      threads);
+  parallel_sort(pairs.begin(), pairs.end(), std::less<>{}, threads);
+  return pairs;
+}
+
+// Number of pairs intersecting_pairs would return, without storing them.
+template <typename T>
+  requires point_numeric<T>
+size_t count_intersecting_pairs(std::span<const Line<T, 2>> segments,
+                                size_t threads = 0,
+                                size_t tiles_per_axis = 0) {
+  detail::segment_tiling<T> tiling(segments, tiles_per_axis, threads);
+  std::atomic<size_t> total{0};
+  parallel_for(
+      0, tiling.tile_count(), 1,
+      [&](size_t begin, size_t end) {
+        size_t local = 0;
+        for (size_t t = begin; t < end; ++t)
+          tiling.join_tile(segments, t, [&](size_t, size_t) { ++local; });
+        total.fetch_add(local, std::memory_order_relaxed);
+      },
+      threads);
+  return total.load();
+}
+
+} // namespace GeomCPP
@@ -0,0 +1,402 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define GEOMCPP_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define GEOMCPP_SIMD_X86 0
+#endif
+
+// Generic loop bodies are force-inlined into per-ISA wrappers (functions with
+// a target attribute) so the compiler vectorizes each copy for that ISA.
+#if defined(__GNUC__)
+#define GEOMCPP_ALWAYS_INLINE [[gnu::always_inline]] inline
+#else
+#define GEOMCPP_ALWAYS_INLINE inline
+#endif
+
+// Marks kernel outputs as unaliased; without it the vectorizer gives up on
+// loops that write several arrays.
+#if defined(__GNUC__)
+#define GEOMCPP_RESTRICT __restrict__
+#else
+#define GEOMCPP_RESTRICT
+#endif
+
+namespace GeomCPP {
+
+enum class simd_level { scalar, sse2, avx2, avx512 };
+
+// Point operations at or above this dimension go through the dispatched
+// kernels; below it the plain loops are cheaper than the call.
+inline constexpr size_t simd_dispatch_threshold = 16;
+
+// One entry per kernel and element type, filled in for a single ISA level.
+struct simd_kernels {
+  simd_level level;
+  float (*dot_f32)(const float *, const float *, size_t);
+  float (*squared_distance_f32)(const float *, const float *, size_t);
+  double (*dot_f64)(const double *, const double *, size_t);
+  double (*squared_distance_f64)(const double *, const double *, size_t);
+};
+
+namespace detail {
+
+template <typename T> T scalar_dot(const T *lhs, const T *rhs, size_t count) {
+  T result = 0;
+  for (size_t i = 0; i < count; ++i)
+    result += lhs[i] * rhs[i];
+  return result;
+}
+
+template <typename T>
+T scalar_squared_distance(const T *lhs, const T *rhs, size_t count) {
+  T result = 0;
+  for (size_t i = 0; i < count; ++i) {
+    T diff = lhs[i] - rhs[i];
+    result += diff * diff;
+  }
+  return result;
+}
+
+#if GEOMCPP_SIMD_X86
+
+// SSE2 is part of the x86-64 baseline, so these need no target attribute.
+inline float horizontal_sum(__m128 sum) {
+  __m128 shuffled = _mm_movehl_ps(sum, sum);
+  sum = _mm_add_ps(sum, shuffled);
+  shuffled = _mm_shuffle_ps(sum, sum, 0x55);
+  return _mm_cvtss_f32(_mm_add_ss(sum, shuffled));
+}
+
+inline double horizontal_sum(__m128d sum) {
+  return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+inline float sse2_dot_f32(const float *lhs, const float *rhs, size_t count) {
+  __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    acc0 = _mm_add_ps(acc0,
+                      _mm_mul_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i)));
+    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(lhs + i + 4),
+                                       _mm_loadu_ps(rhs + i + 4)));
+  }
+  float result = horizontal_sum(_mm_add_ps(acc0, acc1));
+  return result + scalar_dot(lhs + i, rhs + i, count - i);
+}
+
+inline float sse2_squared_distance_f32(const float *lhs, const float *rhs,
+                                       size_t count) {
+  __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128 diff0 = _mm_sub_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i));
+    __m128 diff1 =
+        _mm_sub_ps(_mm_loadu_ps(lhs + i + 4), _mm_loadu_ps(rhs + i + 4));
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(diff0, diff0));
+    acc1 = _mm_add_ps(acc1, _mm_mul_ps(diff1, diff1));
+  }
+  float result = horizontal_sum(_mm_add_ps(acc0, acc1));
+  return result + scalar_squared_distance(lhs + i, rhs + i, count - i);
+}
+
+inline double sse2_dot_f64(const double *lhs, const double *rhs,
+                           size_t count) {
+  __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    acc0 = _mm_add_pd(acc0,
+                      _mm_mul_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+    acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(lhs + i + 2),
+                                       _mm_loadu_pd(rhs + i + 2)));
+  }
+  double result = horizontal_sum(_mm_add_pd(acc0, acc1));
+  return result + scalar_dot(lhs + i, rhs + i, count - i);
+}
+
+inline double sse2_squared_distance_f64(const double *lhs, const double *rhs,
+                                        size_t count) {
+  __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128d diff0 = _mm_sub_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i));
+    __m128d diff1 =
+        _mm_sub_pd(_mm_loadu_pd(lhs + i + 2), _mm_loadu_pd(rhs + i + 2));
+    acc0 = _mm_add_pd(acc0, _mm_mul_pd(diff0, diff0));
+    acc1 = _mm_add_pd(acc1, _mm_mul_pd(diff1, diff1));
+  }
+  double result = horizontal_sum(_mm_add_pd(acc0, acc1));
+  return result + scalar_squared_distance(lhs + i, rhs + i, count - i);
+}
+
+__attribute__((target("avx2,fma"))) inline float
+avx2_horizontal_sum(__m256 sum) {
+  return horizontal_sum(
+      _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1)));
+}
+
+__attribute__((target("avx2,fma"))) inline double
+avx2_horizontal_sum(__m256d sum) {
+  return horizontal_sum(
+      _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1)));
+}
+
+__attribute__((target("avx2,fma"))) inline float
+avx2_dot_f32(const float *lhs, const float *rhs, size_t count) {
+  __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+  __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i),
+                           acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(lhs + i + 8),
+                           _mm256_loadu_ps(rhs + i + 8), acc1);
+    acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(lhs + i + 16),
+                           _mm256_loadu_ps(rhs + i + 16), acc2);
+    acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(lhs + i + 24),
+                           _mm256_loadu_ps(rhs + i + 24), acc3);
+  }
+  for (; i + 8 <= count; i += 8)
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i),
+                           acc0);
+  float result = avx2_horizontal_sum(
+      _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+  return result + scalar_dot(lhs + i, rhs + i, count - i);
+}
+
+__attribute__((target("avx2,fma"))) inline float
+avx2_squared_distance_f32(const float *lhs, const float *rhs, size_t count) {
+  __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256 diff0 =
+        _mm256_sub_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i));
+    __m256 diff1 = _mm256_sub_ps(_mm256_loadu_ps(lhs + i + 8),
+                                 _mm256_loadu_ps(rhs + i + 8));
+    acc0 = _mm256_fmadd_ps(diff0, diff0, acc0);
+    acc1 = _mm256_fmadd_ps(diff1, diff1, acc1);
+  }
+  for (; i + 8 <= count; i += 8) {
+    __m256 diff =
+        _mm256_sub_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i));
+    acc0 = _mm256_fmadd_ps(diff, diff, acc0);
+  }
+  float result = avx2_horizontal_sum(_mm256_add_ps(acc0, acc1));
+  return result + scalar_squared_distance(lhs + i, rhs + i, count - i);
+}
+
+__attribute__((target("avx2,fma"))) inline double
+avx2_dot_f64(const double *lhs, const double *rhs, size_t count) {
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i),
+                           acc0);
+    acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(lhs + i + 4),
+                           _mm256_loadu_pd(rhs + i + 4), acc1);
+  }
+  for (; i + 4 <= count; i += 4)
+    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i),
+                           acc0);
+  double result = avx2_horizontal_sum(_mm256_add_pd(acc0, acc1));
+  return result + scalar_dot(lhs + i, rhs + i, count - i);
+}
+
+__attribute__((target("avx2,fma"))) inline double
+avx2_squared_distance_f64(const double *lhs, const double *rhs, size_t count) {
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256d diff0 =
+        _mm256_sub_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i));
+    __m256d diff1 = _mm256_sub_pd(_mm256_loadu_pd(lhs + i + 4),
+                                  _mm256_loadu_pd(rhs + i + 4));
+    acc0 = _mm256_fmadd_pd(diff0, diff0, acc0);
+    acc1 = _mm256_fmadd_pd(diff1, diff1, acc1);
+  }
+  for (; i + 4 <= count; i += 4) {
+    __m256d diff =
+        _mm256_sub_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i));
+    acc0 = _mm256_fmadd_pd(diff, diff, acc0);
+  }
+  double result = avx2_horizontal_sum(_mm256_add_pd(acc0, acc1));
+  return result + scalar_squared_distance(lhs + i, rhs + i, count - i);
+}
+
+// Folds the two 256-bit halves, then reuses the AVX2 reduction. Written out
+// instead of _mm512_reduce_add_*, whose GCC 12 implementation trips
+// -Wuninitialized in every file that includes this header; the zero-masked
+// extracts avoid the _mm256_undefined_pd source that causes it.
+__attribute__((target("avx512f"))) inline double
+avx512_horizontal_sum(__m512d sum) {
+  return avx2_horizontal_sum(
+      _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xFF, sum, 0),
+                    _mm512_maskz_extractf64x4_pd(0xFF, sum, 1)));
+}
+
+__attribute__((target("avx512f"))) inline float
+avx512_horizontal_sum(__m512 sum) {
+  __m512d halves = _mm512_castps_pd(sum);
+  return avx2_horizontal_sum(_mm256_add_ps(
+      _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, halves, 0)),
+      _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, halves, 1))));
+}
+
+// AVX-512 handles the tail with a masked load instead of a scalar loop.
+__attribute__((target("avx512f"))) inline float
+avx512_dot_f32(const float *lhs, const float *rhs, size_t count) {
+  __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(lhs + i), _mm512_loadu_ps(rhs + i),
+                           acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(lhs + i + 16),
+                           _mm512_loadu_ps(rhs + i + 16), acc1);
+  }
+  for (; i < count; i += 16) {
+    __mmask16 mask = count - i >= 16
+                         ? static_cast<__mmask16>(0xFFFF)
+                         : static_cast<__mmask16>((1u << (count - i)) - 1);
+    acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, lhs + i),
+                           _mm512_maskz_loadu_ps(mask, rhs + i), acc0);
+  }
+  return avx512_horizontal_sum(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline float
+avx512_squared_distance_f32(const float *lhs, const float *rhs, size_t count) {
+  __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m512 diff0 =
+        _mm512_sub_ps(_mm512_loadu_ps(lhs + i), _mm512_loadu_ps(rhs + i));
+    __m512 diff1 = _mm512_sub_ps(_mm512_loadu_ps(lhs + i + 16),
+                                 _mm512_loadu_ps(rhs + i + 16));
+    acc0 = _mm512_fmadd_ps(diff0, diff0, acc0);
+    acc1 = _mm512_fmadd_ps(diff1, diff1, acc1);
+  }
+  for (; i < count; i += 16) {
+    __mmask16 mask = count - i >= 16
+                         ? static_cast<__mmask16>(0xFFFF)
+                         : static_cast<__mmask16>((1u << (count - i)) - 1);
+    __m512 diff = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, lhs + i),
+                                _mm512_maskz_loadu_ps(mask, rhs + i));
+    acc0 = _mm512_fmadd_ps(diff, diff, acc0);
+  }
+  return avx512_horizontal_sum(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline double
+avx512_dot_f64(const double *lhs, const double *rhs, size_t count) {
+  __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i),
+                           acc0);
+    acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(lhs + i + 8),
+                           _mm512_loadu_pd(rhs + i + 8), acc1);
+  }
+  for (; i < count; i += 8) {
+    __mmask8 mask = count - i >= 8
+                        ? static_cast<__mmask8>(0xFF)
+                        : static_cast<__mmask8>((1u << (count - i)) - 1);
+    acc0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, lhs + i),
+                           _mm512_maskz_loadu_pd(mask, rhs + i), acc0);
+  }
+  return avx512_horizontal_sum(_mm512_add_pd(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline double
+avx512_squared_distance_f64(const double *lhs, const double *rhs,
+                            size_t count) {
+  __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512d diff0 =
+        _mm512_sub_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i));
+    __m512d diff1 = _mm512_sub_pd(_mm512_loadu_pd(lhs + i + 8),
+                                  _mm512_loadu_pd(rhs + i + 8));
+    acc0 = _mm512_fmadd_pd(diff0, diff0, acc0);
+    acc1 = _mm512_fmadd_pd(diff1, diff1, acc1);
+  }
+  for (; i < count; i += 8) {
+    __mmask8 mask = count - i >= 8
+                        ? static_cast<__mmask8>(0xFF)
+                        : static_cast<__mmask8>((1u << (count - i)) - 1);
+    __m512d diff = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, lhs + i),
+                                 _mm512_maskz_loadu_pd(mask, rhs + i));
+    acc0 = _mm512_fmadd_pd(diff, diff, acc0);
+  }
+  return avx512_horizontal_sum(_mm512_add_pd(acc0, acc1));
+}
+
+#endif // GEOMCPP_SIMD_X86
+
+} // namespace detail
+
+// Highest kernel level the running CPU supports.
+inline simd_level detect_simd_level() {
+#if GEOMCPP_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return simd_level::avx512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return simd_level::avx2;
+  if (__builtin_cpu_supports("sse2"))
+    return simd_level::sse2;
+#endif
+  return simd_level::scalar;
+}
+
+// Kernel table for a given level. Levels the build cannot provide fall back
+// to the scalar loops; callers must not request more than the CPU supports.
+inline simd_kernels simd_kernels_for(simd_level level) {
+#if GEOMCPP_SIMD_X86
+  switch (level) {
+  case simd_level::avx512:
+    return {level, detail::avx512_dot_f32, detail::avx512_squared_distance_f32,
+            detail::avx512_dot_f64, detail::avx512_squared_distance_f64};
+  case simd_level::avx2:
+    return {level, detail::avx2_dot_f32, detail::avx2_squared_distance_f32,
+            detail::avx2_dot_f64, detail::avx2_squared_distance_f64};
+  case simd_level::sse2:
+    return {level, detail::sse2_dot_f32, detail::sse2_squared_distance_f32,
+            detail::sse2_dot_f64, detail::sse2_squared_distance_f64};
+  case simd_level::scalar:
+    break;
+  }
+#endif
+  return {simd_level::scalar, detail::scalar_dot<float>,
+          detail::scalar_squared_distance<float>, detail::scalar_dot<double>,
+          detail::scalar_squared_distance<double>};
+}
+
+// Dispatch table chosen once, on first use, for the host CPU.
+inline const simd_kernels &active_simd_kernels() {
+  static const simd_kernels kernels = simd_kernels_for(detect_simd_level());
+  return kernels;
+}
+
+template <typename T>
+concept simd_element = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <simd_element T>
+T simd_dot(const T *lhs, const T *rhs, size_t count) {
+  if constexpr (std::is_same_v<T, float>)
+    return active_simd_kernels().dot_f32(lhs, rhs, count);
+  else
+    return active_simd_kernels().dot_f64(lhs, rhs, count);
+}
+
+template <simd_element T>
+T simd_squared_distance(const T *lhs, const T *rhs, size_t count) {
+  if constexpr (std::is_same_v<T, float>)
+    return active_simd_kernels().squared_distance_f32(lhs, rhs, count);
+  else
+    return active_simd_kernels().squared_distance_f64(lhs, rhs, count);
+}
+
+} // namespace GeomCPP
@@ -0,0 +1,333 @@
+#pragma once
+#include "./Parallel.hpp"
+#include "./PointCloud.hpp"
+#include "./Simd_dispatch.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace GeomCPP {
+
+// Space-filling-curve keys for 2D and 3D points. Coordinates are quantized
+// against the bounding box of the batch to 32 (2D) or 21 (3D) bits per axis
+// and the cell indices interleaved into a single 64-bit key, so sorting by
+// key puts spatially close points close together in memory.
+enum class curve { morton, hilbert };
+
+using curve_key = std::uint64_t;
+
+template <size_t Dim>
+  requires(Dim == 2 || Dim == 3)
+inline constexpr unsigned curve_bits = Dim == 2 ? 32 : 21;
+
+namespace detail {
+
+constexpr curve_key spread_bits_2d(std::uint32_t value) {
+  curve_key x = value;
+  x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+  x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+  x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+  x = (x | (x << 2)) & 0x3333333333333333ull;
+  x = (x | (x << 1)) & 0x5555555555555555ull;
+  return x;
+}
+
+constexpr curve_key spread_bits_3d(std::uint32_t value) {
+  curve_key x = value & 0x1FFFFFu;
+  x = (x | (x << 32)) & 0x001F00000000FFFFull;
+  x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+  x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+  x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+  x = (x | (x << 2)) & 0x1249249249249249ull;
+  return x;
+}
+
+// Axis 0 lands in the lowest bit of every group.
+template <size_t Dim>
+constexpr curve_key interleave(const std::array<std::uint32_t, Dim> &cell) {
+  if constexpr (Dim == 2)
+    return spread_bits_2d(cell[0]) | (spread_bits_2d(cell[1]) << 1);
+  else
+    return spread_bits_3d(cell[0]) | (spread_bits_3d(cell[1]) << 1) |
+           (spread_bits_3d(cell[2]) << 2);
+}
+
+#if GEOMCPP_SIMD_X86
+template <size_t Dim>
+__attribute__((target("bmi2"))) inline curve_key
+interleave_pdep(const std::array<std::uint32_t, Dim> &cell) {
+  if constexpr (Dim == 2)
+    return _pdep_u64(cell[0], 0x5555555555555555ull) |
+           _pdep_u64(cell[1], 0xAAAAAAAAAAAAAAAAull);
+  else
+    return _pdep_u64(cell[0], 0x1249249249249249ull) |
+           _pdep_u64(cell[1], 0x2492492492492492ull) |
+           _pdep_u64(cell[2], 0x4924924924924924ull);
+}
+#endif
+
+// Skilling, "Programming the Hilbert curve" (2004): rewrites the cell in
+// place so that interleaving it, first axis most significant, gives the
+// Hilbert index.
+template <size_t Dim>
+constexpr void hilbert_transpose(std::array<std::uint32_t, Dim> &cell,
+                                 unsigned bits) {
+  std::uint32_t top = std::uint32_t{1} << (bits - 1);
+  for (std::uint32_t q = top; q > 1; q >>= 1) {
+    std::uint32_t p = q - 1;
+    for (size_t i = 0; i < Dim; ++i) {
+      if (cell[i] & q) {
+        cell[0] ^= p;
+      } else {
+        std::uint32_t t = (cell[0] ^ cell[i]) & p;
+        cell[0] ^= t;
+        cell[i] ^= t;
+      }
+    }
+  }
+
+  for (size_t i = 1; i < Dim; ++i)
+    cell[i] ^= cell[i - 1];
+  std::uint32_t t = 0;
+  for (std::uint32_t q = top; q > 1; q >>= 1)
+    if (cell[Dim - 1] & q)
+      t ^= q - 1;
+  for (size_t i = 0; i < Dim; ++i)
+    cell[i] ^= t;
+
+  // Interleaving puts axis 0 lowest, so reverse the axis order.
+  for (size_t i = 0; i < Dim / 2; ++i)
+    std::swap(cell[i], cell[Dim - 1 - i]);
+}
+
+} // namespace detail
+
+constexpr curve_key morton_encode(std::uint32_t x, std::uint32_t y) {
+  return detail::interleave<2>({x, y});
+}
+
+// Only the low 21 bits of each coordinate are used.
+constexpr curve_key morton_encode(std::uint32_t x, std::uint32_t y,
+                                  std::uint32_t z) {
+  return detail::interleave<3>({x, y, z});
+}
+
+// Hilbert index of a cell on a 2^bits grid per axis.
+template <size_t Dim>
+  requires(Dim == 2 || Dim == 3)
+constexpr curve_key hilbert_encode(std::array<std::uint32_t, Dim> cell,
+                                   unsigned bits = curve_bits<Dim>) {
+  detail::hilbert_transpose(cell, bits);
+  return detail::interleave<Dim>(cell);
+}
+
+namespace detail {
+
+template <size_t Dim> struct curve_cells {
+  std::array<const std::uint32_t *, Dim> axes;
+};
+
+template <size_t Dim, bool UsePdep>
+GEOMCPP_ALWAYS_INLINE curve_key encode_cell(std::array<std::uint32_t, Dim> cell,
+                                            curve kind) {
+  if (kind == curve::hilbert)
+    hilbert_transpose(cell, curve_bits<Dim>);
+#if GEOMCPP_SIMD_X86
+  if constexpr (UsePdep)
+    return interleave_pdep<Dim>(cell);
+#endif
+  return interleave<Dim>(cell);
+}
+
+template <size_t Dim>
+void encode_keys_portable(curve_cells<Dim> cells, size_t count, curve kind,
+                          curve_key *keys) {
+  for (size_t i = 0; i < count; ++i) {
+    std::array<std::uint32_t, Dim> cell;
+    for (size_t d = 0; d < Dim; ++d)
+      cell[d] = cells.axes[d][i];
+    keys[i] = encode_cell<Dim, false>(cell, kind);
+  }
+}
+
+#if GEOMCPP_SIMD_X86
+template <size_t Dim>
+__attribute__((target("bmi2"))) void
+encode_keys_bmi2(curve_cells<Dim> cells, size_t count, curve kind,
+                 curve_key *keys) {
+  for (size_t i = 0; i < count; ++i) {
+    std::array<std::uint32_t, Dim> cell;
+    for (size_t d = 0; d < Dim; ++d)
+      cell[d] = cells.axes[d][i];
+    keys[i] = encode_cell<Dim, true>(cell, kind);
+  }
+}
+#endif
+
+inline bool host_supports_bmi2() {
+#if GEOMCPP_SIMD_X86
+  static const bool supported = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") != 0;
+  }();
+  return supported;
+#else
+  return false;
+#endif
+}
+
+template <size_t Dim>
+void encode_keys(curve_cells<Dim> cells, size_t count, curve kind,
+                 curve_key *keys) {
+#if GEOMCPP_SIMD_X86
+  if (host_supports_bmi2())
+    return encode_keys_bmi2<Dim>(cells, count, kind, keys);
+#endif
+  encode_keys_portable<Dim>(cells, count, kind, keys);
+}
+
+// Points quantized per block of this size before the encode kernel runs.
+inline constexpr size_t curve_block = 512;
+
+// coordinate(i, d) returns axis d of point i.
+template <size_t Dim, typename Coordinate>
+std::vector<curve_key> curve_keys(size_t count, Coordinate coordinate,
+                                  curve kind, size_t threads) {
+  std::array<double, Dim> lower, scale;
+  for (size_t d = 0; d < Dim; ++d) {
+    double lo = std::numeric_limits<double>::infinity();
+    double hi = -lo;
+    for (size_t i = 0; i < count; ++i) {
+      double value = coordinate(i, d);
+      lo = std::min(lo, value);
+      hi = std::max(hi, value);
+    }
+    constexpr double top =
+        static_cast<double>((curve_key{1} << curve_bits<Dim>) - 1);
+    lower[d] = lo;
+    scale[d] = hi > lo ? top / (hi - lo) : 0.0;
+  }
+
+  std::vector<curve_key> keys(count);
+  parallel_for(
+      0, count, 16 * curve_block,
+      [&](size_t begin, size_t end) {
+        constexpr double top =
+            static_cast<double>((curve_key{1} << curve_bits<Dim>) - 1);
+        std::array<std::array<std::uint32_t, curve_block>, Dim> block;
+        curve_cells<Dim> cells;
+        for (size_t d = 0; d < Dim; ++d)
+          cells.axes[d] = block[d].data();
+
+        for (size_t lo = begin; lo < end; lo += curve_block) {
+          size_t n = std::min(curve_block, end - lo);
+          for (size_t d = 0; d < Dim; ++d)
+            for (size_t i = 0; i < n; ++i) {
+              double cell = (coordinate(lo + i, d) - lower[d]) * scale[d];
+              block[d][i] = static_cast<std::uint32_t>(std::min(cell, top));
+            }
+          encode_keys<Dim>(cells, n, kind, keys.data() + lo);
+        }
+      },
+      threads);
+  return keys;
+}
+
+// Indices of the points in ascending key order; ties keep no particular
+// order.
+inline std::vector<size_t> key_order(const std::vector<curve_key> &keys,
+                                     size_t threads) {
+  std::vector<std::pair<curve_key, size_t>> entries(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+    entries[i] = {keys[i], i};
+  parallel_sort(entries.begin(), entries.end(), std::less<>{}, threads);
+
+  std::vector<size_t> order(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+    order[i] = entries[i].second;
+  return order;
+}
+
+} // namespace detail
+
+// One key per point; the quantization grid spans the bounding box of the
+// input. threads == 0 uses every hardware thread.
+template <typename T, size_t Dim>
+  requires point_numeric<T> && (Dim == 2 || Dim == 3)
+std::vector<curve_key> curve_keys(const PointCloud<T, Dim> &cloud,
+                                  curve kind = curve::morton,
+                                  size_t threads = 0) {
+  std::array<const T *, Dim> axes;
+  for (size_t d = 0; d < Dim; ++d)
+    axes[d] = cloud.axis_data(d);
+  return detail::curve_keys<Dim>(
+      cloud.size(),
+      [&](size_t i, size_t d) { return static_cast<double>(axes[d][i]); },
+      kind, threads);
+}
+
+template <typename T, size_t Dim>
+  requires point_numeric<T> && (Dim == 2 || Dim == 3)
+std::vector<curve_key> curve_keys(const std::vector<Point<T, Dim>> &points,
+                                  curve kind = curve::morton,
+                                  size_t threads = 0) {
+  return detail::curve_keys<Dim>(
+      points.size(),
+      [&](size_t i, size_t d) {
+        return static_cast<double>(points[i].coordinate(d));
+      },
+      kind, threads);
+}
+
+// Permutation that visits the points along the curve. threads == 0 uses every
+// hardware thread.
+template <typename T, size_t Dim>
+  requires point_numeric<T> && (Dim == 2 || Dim == 3)
+std::vector<size_t> spatial_order(const PointCloud<T, Dim> &cloud,
+                                  curve kind = curve::morton,
+                                  size_t threads = 0) {
+  return detail::key_order(curve_keys(cloud, kind, threads), threads);
+}
+
+template <typename T, size_t Dim>
+  requires point_numeric<T> && (Dim == 2 || Dim == 3)
+std::vector<size_t> spatial_order(const std::vector<Point<T, Dim>> &points,
+                                  curve kind = curve::morton,
+                                  size_t threads = 0) {
+  return detail::key_order(curve_keys(points, kind, threads), threads);
+}
+
+// Reorders the points in place along the curve. threads == 0 uses every
+// hardware thread.
+template <typename T, size_t Dim>
+  requires point_numeric<T> && (Dim == 2 || Dim == 3)
+void spatial_sort(PointCloud<T, Dim> &cloud, curve kind = curve::morton,
+                  size_t threads = 0) {
+  std::vector<size_t> order = spatial_order(cloud, kind, threads);
+  PointCloud<T, Dim> sorted(cloud.size());
+  for (size_t d = 0; d < Dim; ++d) {
+    const T *in = cloud.axis_data(d);
+    T *out = sorted.axis_data(d);
+    for (size_t i = 0; i < order.size(); ++i)
+      out[i] = in[order[i]];
+  }
+  cloud = std::move(sorted);
+}
+
+template <typename T, size_t Dim>
+  requires point_numeric<T> && (Dim == 2 || Dim == 3)
+void spatial_sort(std::vector<Point<T, Dim>> &points,
+                  curve kind = curve::morton, size_t threads = 0) {
+  std::vector<size_t> order = spatial_order(points, kind, threads);
+  std::vector<Point<T, Dim>> sorted;
+  sorted.reserve(points.size());
+  for (size_t index : order)
+    sorted.push_back(points[index]);
+  points = std::move(sorted);
+}
+
+} // namespace GeomCPP
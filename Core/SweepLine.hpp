@@ -0,0 +1,571 @@
+#pragma once
+#include "./Line.hpp"
+#include "./Predicates.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace GeomCPP {
+
+// Bentley-Ottmann sweep reporting every pair of 2D segments for which
+// Line::intersects holds, in O((n + k) log n). Parallel pairs, collinear
+// overlaps included, are not reported, matching Line::intersects.
+//
+// Every decision is made exactly on the input coordinates: the status order
+// at an endpoint comes from orientation tests against that endpoint, and
+// segments meeting at a point are reordered by comparing their directions.
+// Crossing events carry conservative intervals around the crossing point;
+// when those cannot order two events, the rational crossing coordinates are
+// compared with floating-point expansions. Segments passing through a common
+// point are handled as one run, so pairs are reported once however many
+// segments meet there. Coordinates are widened to double for the exact
+// tests, so 64-bit integers and long double are exact only up to that.
+template <typename T>
+  requires point_numeric<T>
+class SweepLine {
+public:
+  using line = Line<T, 2>;
+  using real = std::conditional_t<std::is_floating_point_v<accumulate_t<T>>,
+                                  accumulate_t<T>, double>;
+
+  struct intersection {
+    size_t first, second; // input positions, first < second
+    Point<real, 2> point;
+  };
+
+private:
+  using index = std::uint32_t;
+
+  // (x0, y0) is the lexicographically smaller endpoint.
+  struct segment {
+    T x0, y0, x1, y1;
+  };
+
+  struct endpoint_event {
+    index id;
+    bool start;
+  };
+
+  // [lo[k], hi[k]] holds coordinate k of the exact crossing point.
+  struct crossing_event {
+    std::array<double, 2> lo, hi;
+    index lower, upper; // status order just before the crossing
+  };
+
+  // Heap order: the crossing later in the sweep compares greater.
+  struct crossing_later {
+    const SweepLine *sweep;
+    bool operator()(const crossing_event &a, const crossing_event &b) const {
+      return sweep->compare_crossings(a, b) > 0;
+    }
+  };
+
+  // Status entries are permuted in place when segments swap at a point;
+  // that keeps the tree ordered, so the id is mutable.
+  struct slot {
+    mutable index id;
+  };
+  struct probe {}; // stands for the current endpoint in status lookups
+
+  struct status_compare {
+    using is_transparent = void;
+    const SweepLine *sweep;
+
+    bool operator()(const slot &a, const slot &b) const {
+      return sweep->below(a.id, b.id);
+    }
+    bool operator()(const slot &a, probe) const {
+      return sweep->side(a.id) > 0;
+    }
+    bool operator()(probe, const slot &b) const {
+      return sweep->side(b.id) < 0;
+    }
+  };
+
+  using status_tree = std::set<slot, status_compare>;
+
+  std::vector<line> lines;
+  std::vector<segment> segments;
+  std::vector<endpoint_event> endpoints; // sorted once, by point
+  // Reused by every sweep.
+  std::vector<crossing_event> crossings; // min-heap
+  std::unordered_map<std::uint64_t, bool> crossing_pairs; // -> reported
+  std::vector<typename status_tree::iterator> where;
+  std::vector<char> through, at_endpoint;
+  std::vector<index> rank;
+  // Scratch for one event.
+  std::vector<index> started, ended, passing, touching, old_order;
+  std::vector<typename status_tree::iterator> run;
+  T event_x{}, event_y{};
+
+  T point_x(const endpoint_event &e) const {
+    return e.start ? segments[e.id].x0 : segments[e.id].x1;
+  }
+  T point_y(const endpoint_event &e) const {
+    return e.start ? segments[e.id].y0 : segments[e.id].y1;
+  }
+
+  // Sign of the current endpoint against s: positive above, zero on it.
+  int side(index s) const {
+    const segment &g = segments[s];
+    return orientation_sign(g.x0, g.y0, g.x1, g.y1, event_x, event_y);
+  }
+
+  // Order just past a point both segments pass through.
+  bool after(index a, index b) const {
+    const segment &g = segments[a], &h = segments[b];
+    int turn =
+        cross_sign(g.x0, g.y0, g.x1, g.y1, h.x0, h.y0, h.x1, h.y1);
+    return turn != 0 ? turn > 0 : a < b;
+  }
+
+  bool below(index a, index b) const {
+    if (a == b)
+      return false;
+    if (through[a] && through[b])
+      return after(a, b);
+    if (through[a])
+      return side(b) < 0;
+    if (through[b])
+      return side(a) > 0;
+    // Not reached by insertions, which always involve a segment through
+    // the current endpoint.
+    return y_at(a, event_x) < y_at(b, event_x);
+  }
+
+  real y_at(index s, T x) const {
+    const segment &g = segments[s];
+    if (g.x0 == g.x1)
+      return static_cast<real>(g.y0);
+    real t = (static_cast<real>(x) - static_cast<real>(g.x0)) /
+             (static_cast<real>(g.x1) - static_cast<real>(g.x0));
+    return static_cast<real>(g.y0) +
+           t * (static_cast<real>(g.y1) - static_cast<real>(g.y0));
+  }
+
+  // True when the segments cross at a point interior to both.
+  bool properly_cross(index a, index b) const {
+    const segment &g = segments[a], &h = segments[b];
+    int o1 = orientation_sign(g.x0, g.y0, g.x1, g.y1, h.x0, h.y0);
+    int o2 = orientation_sign(g.x0, g.y0, g.x1, g.y1, h.x1, h.y1);
+    int o3 = orientation_sign(h.x0, h.y0, h.x1, h.y1, g.x0, g.y0);
+    int o4 = orientation_sign(h.x0, h.y0, h.x1, h.y1, g.x1, g.y1);
+    return o1 * o2 < 0 && o3 * o4 < 0;
+  }
+
+  Point<real, 2> crossing_point(index a, index b) const {
+    const segment &g = segments[a], &h = segments[b];
+    real gx = static_cast<real>(g.x1) - static_cast<real>(g.x0);
+    real gy = static_cast<real>(g.y1) - static_cast<real>(g.y0);
+    real hx = static_cast<real>(h.x1) - static_cast<real>(h.x0);
+    real hy = static_cast<real>(h.y1) - static_cast<real>(h.y0);
+    real ox = static_cast<real>(h.x0) - static_cast<real>(g.x0);
+    real oy = static_cast<real>(h.y0) - static_cast<real>(g.y0);
+    real t = (ox * hy - oy * hx) / (gx * hy - gy * hx);
+    t = std::clamp(t, real{0}, real{1});
+    return Point<real, 2>({static_cast<real>(g.x0) + t * gx,
+                           static_cast<real>(g.y0) + t * gy});
+  }
+
+  // Coordinate k (0 = x, 1 = y) of the start or end of g, as a double.
+  static double start_at(const segment &g, size_t k) {
+    return static_cast<double>(k == 0 ? g.x0 : g.y0);
+  }
+  static double end_at(const segment &g, size_t k) {
+    return static_cast<double>(k == 0 ? g.x1 : g.y1);
+  }
+
+  // With g = segments[a] and h = segments[b] crossing at a point interior to
+  // both, coordinate k of that point is g0[k] + (num / den) (g1[k] - g0[k]),
+  // where num = (h0 - g0) x (h1 - h0) and den = (g1 - g0) x (h1 - h0).
+  struct crossing_terms {
+    detail::expansion<16> num, den;
+  };
+
+  crossing_terms exact_terms(index a, index b) const {
+    using detail::exact_difference;
+    const segment &g = segments[a], &h = segments[b];
+    auto rx = exact_difference(end_at(g, 0), start_at(g, 0));
+    auto ry = exact_difference(end_at(g, 1), start_at(g, 1));
+    auto sx = exact_difference(end_at(h, 0), start_at(h, 0));
+    auto sy = exact_difference(end_at(h, 1), start_at(h, 1));
+    auto ox = exact_difference(start_at(h, 0), start_at(g, 0));
+    auto oy = exact_difference(start_at(h, 1), start_at(g, 1));
+    return {ox * sy - oy * sx, rx * sy - ry * sx};
+  }
+
+  // Sign of (coordinate k of the crossing of e) - value.
+  int exact_compare(const crossing_event &e, size_t k, double value) const {
+    using detail::exact_difference;
+    const segment &g = segments[e.lower];
+    crossing_terms c = exact_terms(e.lower, e.upper);
+    auto scaled = exact_difference(start_at(g, k), value) * c.den +
+                  c.num * exact_difference(end_at(g, k), start_at(g, k));
+    return scaled.sign() * c.den.sign();
+  }
+
+  // Sign of (coordinate k of the crossing of a) - (that of b). Both are
+  // taken relative to b's g0, then cross-multiplied by the denominators.
+  int exact_compare(const crossing_event &a, const crossing_event &b,
+                    size_t k) const {
+    using detail::exact_difference;
+    const segment &g = segments[a.lower], &h = segments[b.lower];
+    double origin = start_at(h, k);
+    crossing_terms c = exact_terms(a.lower, a.upper);
+    crossing_terms d = exact_terms(b.lower, b.upper);
+    auto lhs = exact_difference(start_at(g, k), origin) * c.den +
+               c.num * exact_difference(end_at(g, k), start_at(g, k));
+    auto rhs = d.num * exact_difference(end_at(h, k), origin);
+    auto difference = lhs * d.den - rhs * c.den;
+    return difference.sign() * c.den.sign() * d.den.sign();
+  }
+
+  // Lexicographic comparison of a crossing with the point (x, y).
+  int compare_crossing(const crossing_event &e, double x, double y) const {
+    std::array<double, 2> value{x, y};
+    for (size_t k = 0; k < 2; ++k) {
+      int order = e.hi[k] < value[k]  ? -1
+                  : e.lo[k] > value[k] ? 1
+                                       : exact_compare(e, k, value[k]);
+      if (order != 0)
+        return order;
+    }
+    return 0;
+  }
+
+  // Sign of t_a - t_b for the crossings of g with a and with b, where g's
+  // points run from g0 at t = 0 to g1 at t = 1 in sweep order.
+  int compare_along(index g, index a, index b) const {
+    crossing_terms c = exact_terms(g, a), d = exact_terms(g, b);
+    auto difference = c.num * d.den - d.num * c.den;
+    return difference.sign() * c.den.sign() * d.den.sign();
+  }
+
+  int compare_crossings(const crossing_event &a,
+                        const crossing_event &b) const {
+    if (a.hi[0] < b.lo[0])
+      return -1;
+    if (a.lo[0] > b.hi[0])
+      return 1;
+    // Crossings on a common segment, as at a point where several segments
+    // meet, are ordered along it with smaller expansions.
+    for (index g : {a.lower, a.upper})
+      if (g == b.lower || g == b.upper)
+        return compare_along(g, a.lower ^ a.upper ^ g, b.lower ^ b.upper ^ g);
+    for (size_t k = 0; k < 2; ++k) {
+      int order = a.hi[k] < b.lo[k]  ? -1
+                  : a.lo[k] > b.hi[k] ? 1
+                                      : exact_compare(a, b, k);
+      if (order != 0)
+        return order;
+    }
+    return 0;
+  }
+
+  // Conservative bounds on the crossing point: the overlap of the two
+  // bounding boxes, narrowed by an interval evaluation of t when the rounded
+  // denominator clears its error bound.
+  crossing_event bound_crossing(index a, index b) const {
+    constexpr double epsilon = detail::predicate_epsilon;
+    const segment &g = segments[a], &h = segments[b];
+    crossing_event event{{}, {}, a, b};
+    for (size_t k = 0; k < 2; ++k) {
+      event.lo[k] = std::max(std::min(start_at(g, k), end_at(g, k)),
+                             std::min(start_at(h, k), end_at(h, k)));
+      event.hi[k] = std::min(std::max(start_at(g, k), end_at(g, k)),
+                             std::max(start_at(h, k), end_at(h, k)));
+    }
+
+    double rx = end_at(g, 0) - start_at(g, 0);
+    double ry = end_at(g, 1) - start_at(g, 1);
+    double sx = end_at(h, 0) - start_at(h, 0);
+    double sy = end_at(h, 1) - start_at(h, 1);
+    double ox = start_at(h, 0) - start_at(g, 0);
+    double oy = start_at(h, 1) - start_at(g, 1);
+    double den = rx * sy - ry * sx;
+    double den_error = detail::cross_error_bound *
+                       (constexpr_abs(rx * sy) + constexpr_abs(ry * sx));
+    if (!(constexpr_abs(den) > den_error))
+      return event;
+    double num = ox * sy - oy * sx;
+    double num_error = detail::cross_error_bound *
+                       (constexpr_abs(ox * sy) + constexpr_abs(oy * sx));
+
+    double t_lo = 1, t_hi = 0;
+    for (double n : {num - num_error, num + num_error})
+      for (double d : {den - den_error, den + den_error}) {
+        t_lo = std::min(t_lo, n / d);
+        t_hi = std::max(t_hi, n / d);
+      }
+    t_lo = std::max(t_lo - 4 * epsilon * constexpr_abs(t_lo), 0.0);
+    t_hi = std::min(t_hi + 4 * epsilon * constexpr_abs(t_hi), 1.0);
+
+    std::array<double, 2> r{rx, ry};
+    for (size_t k = 0; k < 2; ++k) {
+      double origin = start_at(g, k);
+      double margin =
+          8 * epsilon * (constexpr_abs(origin) + constexpr_abs(r[k]));
+      double first = t_lo * r[k], second = t_hi * r[k];
+      event.lo[k] =
+          std::max(event.lo[k], origin + std::min(first, second) - margin);
+      event.hi[k] =
+          std::min(event.hi[k], origin + std::max(first, second) + margin);
+    }
+    return event;
+  }
+
+  static std::uint64_t pair_key(index a, index b) {
+    if (a > b)
+      std::swap(a, b);
+    return (static_cast<std::uint64_t>(a) << 32) | b;
+  }
+
+  // Queues the crossing of status neighbours lower < upper if they meet
+  // ahead of the sweep and have not been queued before.
+  void schedule(index lower, index upper) {
+    const segment &g = segments[lower], &h = segments[upper];
+    if (cross_sign(g.x0, g.y0, g.x1, g.y1, h.x0, h.y0, h.x1, h.y1) >= 0 ||
+        !properly_cross(lower, upper))
+      return;
+    if (!crossing_pairs.try_emplace(pair_key(lower, upper), false).second)
+      return;
+    crossing_event event = bound_crossing(lower, upper);
+    crossings.push_back(event);
+    std::push_heap(crossings.begin(), crossings.end(), crossing_later{this});
+  }
+
+  void schedule_around(status_tree &status,
+                       typename status_tree::iterator first,
+                       typename status_tree::iterator last) {
+    if (first == last) {
+      if (first != status.begin() && first != status.end())
+        schedule(std::prev(first)->id, first->id);
+      return;
+    }
+    if (first != status.begin())
+      schedule(std::prev(first)->id, first->id);
+    if (last != status.end())
+      schedule(std::prev(last)->id, last->id);
+  }
+
+  // Rewrites the status slots in run, holding order, to the order just past
+  // the point they share, reporting the pairs that swap there.
+  template <bool Points, typename Report>
+  void reorder(std::vector<index> &order, Report &report) {
+    old_order = order;
+    std::sort(order.begin(), order.end(),
+              [&](index a, index b) { return after(a, b); });
+    for (size_t i = 0; i < order.size(); ++i)
+      rank[order[i]] = static_cast<index>(i);
+    for (size_t i = 0; i < old_order.size(); ++i)
+      for (size_t j = i + 1; j < old_order.size(); ++j) {
+        index a = old_order[i], b = old_order[j];
+        if (rank[a] < rank[b] || !properly_cross(a, b))
+          continue;
+        auto [entry, inserted] =
+            crossing_pairs.try_emplace(pair_key(a, b), true);
+        if (!inserted) {
+          if (entry->second)
+            continue;
+          entry->second = true;
+        }
+        emit<Points>(a, b, report,
+                     [&] { return crossing_point(a, b); });
+      }
+    for (size_t i = 0; i < run.size(); ++i) {
+      run[i]->id = order[i];
+      where[order[i]] = run[i];
+    }
+  }
+
+  template <bool Points, typename Report, typename Locate>
+  void emit(index a, index b, Report &report, Locate &&locate) const {
+    if (a > b)
+      std::swap(a, b);
+    if constexpr (Points)
+      report(a, b, locate());
+    else
+      report(a, b, Point<real, 2>({real{0}, real{0}}));
+  }
+
+  template <bool Points, typename Report>
+  void handle_endpoints(status_tree &status, size_t first, size_t last,
+                        Report &report) {
+    event_x = point_x(endpoints[first]);
+    event_y = point_y(endpoints[first]);
+
+    started.clear();
+    ended.clear();
+    passing.clear();
+    run.clear();
+    for (size_t e = first; e < last; ++e) {
+      (endpoints[e].start ? started : ended).push_back(endpoints[e].id);
+      at_endpoint[endpoints[e].id] = 1;
+    }
+    for (auto it = status.lower_bound(probe{});
+         it != status.upper_bound(probe{}); ++it)
+      if (!at_endpoint[it->id]) {
+        run.push_back(it);
+        passing.push_back(it->id);
+      }
+
+    // Pairs meeting at an endpoint of one of them.
+    touching.assign(started.begin(), started.end());
+    touching.insert(touching.end(), ended.begin(), ended.end());
+    size_t with_endpoint = touching.size();
+    touching.insert(touching.end(), passing.begin(), passing.end());
+    for (size_t i = 0; i < with_endpoint; ++i)
+      for (size_t j = i + 1; j < touching.size(); ++j)
+        if (lines[touching[i]].intersects(lines[touching[j]]))
+          emit<Points>(touching[i], touching[j], report, [&] {
+            return Point<real, 2>({static_cast<real>(event_x),
+                                   static_cast<real>(event_y)});
+          });
+
+    for (index s : ended) {
+      status.erase(where[s]);
+      where[s] = status.end();
+    }
+    reorder<Points>(passing, report);
+    for (index s : passing)
+      through[s] = 1;
+    for (index s : started) {
+      through[s] = 1;
+      where[s] = status.insert(slot{s}).first;
+    }
+
+    schedule_around(status, status.lower_bound(probe{}),
+                    status.upper_bound(probe{}));
+    for (index s : passing)
+      through[s] = 0;
+    for (size_t e = first; e < last; ++e) {
+      through[endpoints[e].id] = 0;
+      at_endpoint[endpoints[e].id] = 0;
+    }
+  }
+
+  // Collects the status run from first to last into run, or returns false.
+  bool collect(typename status_tree::iterator first,
+               typename status_tree::iterator last,
+               const status_tree &status) {
+    run.clear();
+    for (auto it = first; it != status.end(); ++it) {
+      run.push_back(it);
+      if (it == last)
+        return true;
+    }
+    return false;
+  }
+
+  template <bool Points, typename Report>
+  void handle_crossing(status_tree &status, const crossing_event &event,
+                       Report &report) {
+    if (crossing_pairs[pair_key(event.lower, event.upper)])
+      return;
+    // Segments between the two at this moment pass through the same point.
+    if (!collect(where[event.lower], where[event.upper], status) &&
+        !collect(where[event.upper], where[event.lower], status))
+      return;
+    passing.clear();
+    for (auto it : run)
+      passing.push_back(it->id);
+    reorder<Points>(passing, report);
+    schedule_around(status, run.front(), std::next(run.back()));
+  }
+
+  template <bool Points, typename Report> void sweep(Report &&report) {
+    status_tree status(status_compare{this});
+    crossings.clear();
+    crossing_pairs.clear();
+
+    size_t next = 0;
+    while (next < endpoints.size() || !crossings.empty()) {
+      bool crossing_next = !crossings.empty();
+      if (crossing_next && next < endpoints.size())
+        crossing_next =
+            compare_crossing(crossings.front(),
+                             static_cast<double>(point_x(endpoints[next])),
+                             static_cast<double>(point_y(endpoints[next]))) <=
+            0;
+      if (crossing_next) {
+        std::pop_heap(crossings.begin(), crossings.end(), crossing_later{this});
+        crossing_event event = crossings.back();
+        crossings.pop_back();
+        handle_crossing<Points>(status, event, report);
+        continue;
+      }
+      size_t last = next + 1;
+      while (last < endpoints.size() &&
+             point_x(endpoints[last]) == point_x(endpoints[next]) &&
+             point_y(endpoints[last]) == point_y(endpoints[next]))
+        ++last;
+      handle_endpoints<Points>(status, next, last, report);
+      next = last;
+    }
+  }
+
+public:
+  explicit SweepLine(std::span<const line> input)
+      : lines(input.begin(), input.end()) {
+    if (lines.size() >= std::numeric_limits<index>::max())
+      throw std::length_error("Too many segments for SweepLine");
+    size_t count = lines.size();
+    segments.reserve(count);
+    endpoints.reserve(2 * count);
+    for (size_t i = 0; i < count; ++i) {
+      auto a = lines[i].get_start(), b = lines[i].get_end();
+      if (b[0] < a[0] || (b[0] == a[0] && b[1] < a[1]))
+        std::swap(a, b);
+      segments.push_back({a[0], a[1], b[0], b[1]});
+      endpoints.push_back({static_cast<index>(i), true});
+      endpoints.push_back({static_cast<index>(i), false});
+    }
+    std::sort(endpoints.begin(), endpoints.end(),
+              [&](const endpoint_event &a, const endpoint_event &b) {
+                T ax = point_x(a), bx = point_x(b);
+                return ax != bx ? ax < bx : point_y(a) < point_y(b);
+              });
+    crossings.reserve(count);
+    where.resize(count);
+    through.assign(count, 0);
+    at_endpoint.assign(count, 0);
+    rank.assign(count, 0);
+  }
+
+  size_t size() const { return lines.size(); }
+
+  // Every intersecting pair with its intersection point, in sweep order.
+  // A sweep reuses the engine's buffers, so one engine serves one thread.
+  std::vector<intersection> intersections() {
+    std::vector<intersection> result;
+    sweep<true>([&](size_t a, size_t b, const Point<real, 2> &p) {
+      result.push_back({a, b, p});
+    });
+    return result;
+  }
+
+  // Calls visit(first, second) for every intersecting pair, in sweep
+  // order, without locating the intersections.
+  template <typename Visit> void for_each_pair(Visit &&visit) {
+    sweep<false>(
+        [&](size_t a, size_t b, const Point<real, 2> &) { visit(a, b); });
+  }
+
+  // Number of intersecting pairs, without storing or locating them.
+  size_t count() {
+    size_t total = 0;
+    for_each_pair([&](size_t, size_t) { ++total; });
+    return total;
+  }
+};
+
+} // namespace GeomCPP
@@ -0,0 +1,359 @@
+#pragma once
+#include "./Parallel.hpp"
+#include "./PointCloud.hpp"
+#include "./Reflection.hpp"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace GeomCPP {
+
+namespace detail {
+
+template <typename Real, size_t Dim>
+using homogeneous_matrix = std::array<std::array<Real, Dim + 1>, Dim + 1>;
+
+// Applies the affine part of matrix to points [begin, end) of coords in place.
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+GEOMCPP_ALWAYS_INLINE void
+affine_coordinates(Coordinates coords, size_t begin, size_t end,
+                   const homogeneous_matrix<Real, Dim> &matrix) {
+  // Local copy: when T == Real the stores could otherwise alias it. The axis
+  // loops are unrolled so the vectorizer works across points.
+  const homogeneous_matrix<Real, Dim> m = matrix;
+  for (size_t i = begin; i < end; ++i) {
+    std::array<Real, Dim> in;
+#pragma GCC unroll 4
+    for (size_t d = 0; d < Dim; ++d)
+      in[d] = static_cast<Real>(coords(i, d));
+#pragma GCC unroll 4
+    for (size_t r = 0; r < Dim; ++r) {
+      Real value = m[r][Dim];
+#pragma GCC unroll 4
+      for (size_t c = 0; c < Dim; ++c)
+        value += m[r][c] * in[c];
+      coords(i, r) = static_cast<T>(value);
+    }
+  }
+}
+
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+using affine_coordinates_fn = void (*)(Coordinates, size_t, size_t,
+                                       const homogeneous_matrix<Real, Dim> &);
+
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+void affine_coordinates_generic(Coordinates coords, size_t begin, size_t end,
+                                const homogeneous_matrix<Real, Dim> &m) {
+  affine_coordinates<T, Dim, Real>(coords, begin, end, m);
+}
+
+#if GEOMCPP_SIMD_X86
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+__attribute__((target("avx2"))) void
+affine_coordinates_avx2(Coordinates coords, size_t begin, size_t end,
+                        const homogeneous_matrix<Real, Dim> &m) {
+  affine_coordinates<T, Dim, Real>(coords, begin, end, m);
+}
+
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+__attribute__((target("avx512f"))) void
+affine_coordinates_avx512(Coordinates coords, size_t begin, size_t end,
+                          const homogeneous_matrix<Real, Dim> &m) {
+  affine_coordinates<T, Dim, Real>(coords, begin, end, m);
+}
+#endif // GEOMCPP_SIMD_X86
+
+template <typename T, size_t Dim, typename Real, typename Coordinates>
+affine_coordinates_fn<T, Dim, Real, Coordinates> active_affine_coordinates() {
+  static const affine_coordinates_fn<T, Dim, Real, Coordinates> kernel = [] {
+#if GEOMCPP_SIMD_X86
+    switch (active_simd_kernels().level) {
+    case simd_level::avx512:
+      return &affine_coordinates_avx512<T, Dim, Real, Coordinates>;
+    case simd_level::avx2:
+      return &affine_coordinates_avx2<T, Dim, Real, Coordinates>;
+    default:
+      break;
+    }
+#endif
+    return &affine_coordinates_generic<T, Dim, Real, Coordinates>;
+  }();
+  return kernel;
+}
+
+} // namespace detail
+
+// Affine (or projective) transform stored as a homogeneous
+// (Dim + 1) x (Dim + 1) matrix acting on column vectors. Composition multiplies
+// the matrices, so a chain of transforms is applied to a point set in a single
+// pass.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class Transform {
+public:
+  using point = Point<T, Dim>;
+  using real = std::conditional_t<std::is_floating_point_v<accumulate_t<T>>,
+                                  accumulate_t<T>, double>;
+  using matrix = detail::homogeneous_matrix<real, Dim>;
+
+  // Points handed to one thread at a time by the batched overloads.
+  static constexpr size_t parallel_grain = 16384;
+
+private:
+  matrix m;
+
+public:
+  constexpr Transform() : m{} {
+    for (size_t i = 0; i <= Dim; ++i)
+      m[i][i] = 1;
+  }
+
+  constexpr explicit Transform(const matrix &values) : m(values) {}
+
+  static constexpr Transform identity() { return Transform(); }
+
+  static constexpr Transform translation(const point &offset) {
+    Transform result;
+    for (size_t d = 0; d < Dim; ++d)
+      result.m[d][Dim] = static_cast<real>(offset[d]);
+    return result;
+  }
+
+  static constexpr Transform scaling(real factor) {
+    Transform result;
+    for (size_t d = 0; d < Dim; ++d)
+      result.m[d][d] = factor;
+    return result;
+  }
+
+  static constexpr Transform scaling(const point &factors) {
+    Transform result;
+    for (size_t d = 0; d < Dim; ++d)
+      result.m[d][d] = static_cast<real>(factors[d]);
+    return result;
+  }
+
+  // Counter-clockwise rotation about the origin, angle in radians.
+  static Transform rotation(real angle)
+    requires(Dim == 2)
+  {
+    Transform result;
+    real c = std::cos(angle), s = std::sin(angle);
+    result.m[0][0] = c;
+    result.m[0][1] = -s;
+    result.m[1][0] = s;
+    result.m[1][1] = c;
+    return result;
+  }
+
+  // Right-handed rotation about an axis through the origin (Rodrigues).
+  static Transform rotation(const point &axis, real angle)
+    requires(Dim == 3)
+  {
+    real length_squared = 0;
+    for (size_t d = 0; d < Dim; ++d)
+      length_squared += static_cast<real>(axis[d]) * static_cast<real>(axis[d]);
+    real length = std::sqrt(length_squared);
+    if (length == 0)
+      throw std::invalid_argument("Rotation axis must be non-zero.");
+
+    real x = static_cast<real>(axis[0]) / length;
+    real y = static_cast<real>(axis[1]) / length;
+    real z = static_cast<real>(axis[2]) / length;
+    real c = std::cos(angle), s = std::sin(angle), t = 1 - c;
+
+    Transform result;
+    result.m[0] = {t * x * x + c, t * x * y - s * z, t * x * z + s * y, 0};
+    result.m[1] = {t * x * y + s * z, t * y * y + c, t * y * z - s * x, 0};
+    result.m[2] = {t * x * z - s * y, t * y * z + s * x, t * z * z + c, 0};
+    return result;
+  }
+
+  // Householder matrix I - 2 n n^T / |n|^2 plus the matching translation.
+  static constexpr Transform reflection(const Reflection<T, Dim> &mirror)
+    requires(Dim == 2 || Dim == 3)
+  {
+    const auto &n = mirror.get_normal();
+    real norm_squared = 0;
+    for (size_t d = 0; d < Dim; ++d)
+      norm_squared += static_cast<real>(n[d]) * static_cast<real>(n[d]);
+
+    Transform result;
+    for (size_t r = 0; r < Dim; ++r) {
+      real factor = 2 * static_cast<real>(n[r]) / norm_squared;
+      for (size_t c = 0; c < Dim; ++c)
+        result.m[r][c] -= factor * static_cast<real>(n[c]);
+      result.m[r][Dim] = -factor * static_cast<real>(mirror.get_offset());
+    }
+    return result;
+  }
+
+  static constexpr Transform reflection(const point &first,
+                                        const point &second)
+    requires(Dim == 2 || Dim == 3)
+  {
+    return reflection(Reflection<T, Dim>(first, second));
+  }
+
+  constexpr const matrix &get_matrix() const { return m; }
+  constexpr real operator()(size_t row, size_t column) const {
+    return m.at(row).at(column);
+  }
+
+  // True when the bottom row is (0, ..., 0, 1), i.e. no perspective divide.
+  constexpr bool is_affine() const {
+    for (size_t c = 0; c < Dim; ++c)
+      if (m[Dim][c] != 0)
+        return false;
+    return m[Dim][Dim] == 1;
+  }
+
+  // (a * b) applies b first, then a.
+  constexpr Transform operator*(const Transform &other) const {
+    Transform result(matrix{});
+    for (size_t r = 0; r <= Dim; ++r)
+      for (size_t k = 0; k <= Dim; ++k)
+        for (size_t c = 0; c <= Dim; ++c)
+          result.m[r][c] += m[r][k] * other.m[k][c];
+    return result;
+  }
+
+  // Composition in application order: a.then(b) applies a, then b.
+  constexpr Transform then(const Transform &next) const {
+    return next * *this;
+  }
+
+  // Gauss-Jordan elimination with partial pivoting.
+  constexpr Transform inverse() const {
+    matrix work = m;
+    matrix result = Transform().m;
+
+    for (size_t col = 0; col <= Dim; ++col) {
+      size_t pivot = col;
+      for (size_t r = col + 1; r <= Dim; ++r)
+        if (constexpr_abs(work[r][col]) > constexpr_abs(work[pivot][col]))
+          pivot = r;
+      if (work[pivot][col] == 0)
+        throw std::runtime_error("Transform is not invertible");
+
+      std::swap(work[col], work[pivot]);
+      std::swap(result[col], result[pivot]);
+
+      real scale = 1 / work[col][col];
+      for (size_t c = 0; c <= Dim; ++c) {
+        work[col][c] *= scale;
+        result[col][c] *= scale;
+      }
+
+      for (size_t r = 0; r <= Dim; ++r) {
+        if (r == col || work[r][col] == 0)
+          continue;
+        real factor = work[r][col];
+        for (size_t c = 0; c <= Dim; ++c) {
+          work[r][c] -= factor * work[col][c];
+          result[r][c] -= factor * result[col][c];
+        }
+      }
+    }
+    return Transform(result);
+  }
+
+  constexpr point apply(const point &p) const {
+    std::array<real, Dim> in;
+    for (size_t d = 0; d < Dim; ++d)
+      in[d] = static_cast<real>(p[d]);
+
+    real w = row_dot(Dim, in);
+    if (w == 0)
+      throw std::runtime_error("Division by zero");
+
+    std::array<T, Dim> coords;
+    for (size_t d = 0; d < Dim; ++d)
+      coords[d] = static_cast<T>(w == 1 ? row_dot(d, in) : row_dot(d, in) / w);
+    return point(coords);
+  }
+
+  constexpr point operator()(const point &p) const { return apply(p); }
+
+  // In-place batched application; threads == 0 uses every hardware thread.
+  void apply(std::span<point> points, size_t threads = 1) const {
+    apply_batch(detail::point_coordinates<T, Dim>{points.data()},
+                points.size(), threads);
+  }
+
+  void apply(PointCloud<T, Dim> &cloud, size_t threads = 1) const {
+    apply_batch(detail::coordinates_of(cloud), cloud.size(), threads);
+  }
+
+private:
+  // Row r of the matrix times the homogeneous point (in, 1).
+  constexpr real row_dot(size_t r, const std::array<real, Dim> &in) const {
+    real value = m[r][Dim];
+    for (size_t c = 0; c < Dim; ++c)
+      value += m[r][c] * in[c];
+    return value;
+  }
+
+  template <typename Coordinates>
+  static std::array<real, Dim> read(Coordinates coords, size_t i) {
+    std::array<real, Dim> in;
+    for (size_t d = 0; d < Dim; ++d)
+      in[d] = static_cast<real>(coords(i, d));
+    return in;
+  }
+
+  template <typename Coordinates>
+  void apply_batch(Coordinates coords, size_t count, size_t threads) const {
+    if (!is_affine()) {
+      apply_projective(coords, count, threads);
+      return;
+    }
+
+    detail::affine_coordinates_fn<T, Dim, real, Coordinates> kernel;
+    if constexpr (simd_element<T>)
+      kernel = detail::active_affine_coordinates<T, Dim, real, Coordinates>();
+    else
+      kernel = &detail::affine_coordinates_generic<T, Dim, real, Coordinates>;
+
+    parallel_for(
+        0, count, parallel_grain,
+        [&](size_t begin, size_t end) { kernel(coords, begin, end, m); },
+        threads);
+  }
+
+  // Every perspective divide is checked before any point is written, so a
+  // degenerate point leaves the whole batch untouched.
+  template <typename Coordinates>
+  void apply_projective(Coordinates coords, size_t count,
+                        size_t threads) const {
+    std::atomic<bool> degenerate{false};
+    parallel_for(
+        0, count, parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i)
+            if (row_dot(Dim, read(coords, i)) == 0)
+              degenerate.store(true, std::memory_order_relaxed);
+        },
+        threads);
+    if (degenerate.load(std::memory_order_relaxed))
+      throw std::runtime_error("Division by zero");
+
+    parallel_for(
+        0, count, parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            std::array<real, Dim> in = read(coords, i);
+            real w = row_dot(Dim, in);
+            for (size_t d = 0; d < Dim; ++d)
+              coords(i, d) = static_cast<T>(row_dot(d, in) / w);
+          }
+        },
+        threads);
+  }
+};
+
+} // namespace GeomCPP
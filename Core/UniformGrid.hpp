@@ -0,0 +1,384 @@
+#pragma once
+#include "./BoundingBox.hpp"
+#include "./Parallel.hpp"
+#include "./PointCloud.hpp"
+#include "./RTree.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace GeomCPP {
+
+// Uniform 2D grid over the bounding box of a static set of points and
+// segments. Every cell is addressed directly by (column, row), and the items
+// of each cell are stored back to back in compressed rows: offsets[c] ..
+// offsets[c + 1] index into one flat item array. Both arrays are filled by a
+// two-pass counting sort, so a build allocates once per table, never per
+// cell. Segments are registered in every cell their closed extent touches.
+template <typename T>
+  requires point_numeric<T>
+class UniformGrid {
+public:
+  using point = Point<T, 2>;
+  using line = Line<T, 2>;
+  using box = BoundingBox<T, 2>;
+  using real = typename box::real;
+
+  // Items handed to one thread at a time while building.
+  static constexpr size_t parallel_grain = 4096;
+  static constexpr size_t max_cells = size_t{1} << 30;
+
+private:
+  using index = std::uint32_t;
+
+  struct table {
+    // Item ids fit in index, but one segment may cover many cells, so the
+    // membership count and the offsets into items need the full size_t.
+    std::vector<size_t> offsets; // cells + 1 entries
+    std::vector<index> items;
+
+    std::span<const index> cell(size_t c) const {
+      return {items.data() + offsets[c], items.data() + offsets[c + 1]};
+    }
+  };
+
+  real cell_size;
+  real origin_x = 0, origin_y = 0;
+  size_t columns = 1, rows = 1;
+
+  PointCloud<T, 2> points;
+  std::vector<line> segments;
+  table point_table, segment_table;
+
+  size_t column_of(real x) const {
+    real cell = std::floor((x - origin_x) / cell_size);
+    return static_cast<size_t>(
+        std::clamp(cell, real{0}, static_cast<real>(columns - 1)));
+  }
+
+  size_t row_of(real y) const {
+    real cell = std::floor((y - origin_y) / cell_size);
+    return static_cast<size_t>(
+        std::clamp(cell, real{0}, static_cast<real>(rows - 1)));
+  }
+
+  // Calls visit(cell) for every cell the closed segment touches: for each
+  // column slab it crosses, the rows spanned by the part inside the slab.
+  // Slab limits are widened slightly so rounding never drops a cell.
+  template <typename Visit>
+  void rasterize(const line &segment, Visit &&visit) const {
+    real ax = static_cast<real>(segment.get_start()[0]);
+    real ay = static_cast<real>(segment.get_start()[1]);
+    real bx = static_cast<real>(segment.get_end()[0]);
+    real by = static_cast<real>(segment.get_end()[1]);
+    if (bx < ax) {
+      std::swap(ax, bx);
+      std::swap(ay, by);
+    }
+
+    real slack = cell_size * 1e-9;
+    size_t first = column_of(ax - slack), last = column_of(bx + slack);
+    for (size_t column = first; column <= last; ++column) {
+      real y0 = ay, y1 = by;
+      if (bx > ax) {
+        real slope = (by - ay) / (bx - ax);
+        real left = std::max(ax, origin_x + column * cell_size - slack);
+        real right =
+            std::min(bx, origin_x + (column + 1) * cell_size + slack);
+        y0 = ay + (left - ax) * slope;
+        y1 = ay + (right - ax) * slope;
+      }
+      if (y1 < y0)
+        std::swap(y0, y1);
+      size_t top = row_of(y1 + slack);
+      for (size_t row = row_of(y0 - slack); row <= top; ++row)
+        visit(row * columns + column);
+    }
+  }
+
+  // Counting sort of (item, cell) memberships into a compressed table.
+  // for_cells(i, visit) enumerates the cells of item i.
+  template <typename ForCells>
+  table build_table(size_t count, ForCells for_cells, size_t threads) {
+    size_t cells = columns * rows;
+    std::vector<std::atomic<size_t>> counts(cells + 1);
+    parallel_for(
+        0, count, parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i)
+            for_cells(i, [&](size_t c) {
+              counts[c].fetch_add(1, std::memory_order_relaxed);
+            });
+        },
+        threads);
+
+    table result;
+    result.offsets.resize(cells + 1);
+    size_t running = 0;
+    for (size_t c = 0; c < cells; ++c) {
+      result.offsets[c] = running;
+      running += counts[c].load(std::memory_order_relaxed);
+      counts[c].store(result.offsets[c], std::memory_order_relaxed);
+    }
+    result.offsets[cells] = running;
+    result.items.resize(running);
+
+    parallel_for(
+        0, count, parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i)
+            for_cells(i, [&](size_t c) {
+              size_t slot = counts[c].fetch_add(1, std::memory_order_relaxed);
+              result.items[slot] = static_cast<index>(i);
+            });
+        },
+        threads);
+
+    // Slots were claimed concurrently; restore a deterministic order.
+    parallel_for(
+        0, cells, parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t c = begin; c < end; ++c)
+            std::sort(result.items.begin() + result.offsets[c],
+                      result.items.begin() + result.offsets[c + 1]);
+        },
+        threads);
+    return result;
+  }
+
+  // Calls visit(cell) for the cells overlapping [x0, x1] x [y0, y1].
+  template <typename Visit>
+  void for_cells_in(real x0, real y0, real x1, real y1, Visit &&visit) const {
+    size_t last_column = column_of(x1), last_row = row_of(y1);
+    for (size_t row = row_of(y0); row <= last_row; ++row)
+      for (size_t column = column_of(x0); column <= last_column; ++column)
+        visit(row * columns + column);
+  }
+
+  static void sort_unique(std::vector<size_t> &ids) {
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  }
+
+public:
+  // threads == 0 uses every hardware thread for the build.
+  UniformGrid(std::span<const point> point_set,
+              std::span<const line> segment_set, real size,
+              size_t threads = 1)
+      : cell_size(size), segments(segment_set.begin(), segment_set.end()) {
+    if (!(cell_size > 0))
+      throw std::invalid_argument("Grid cell size must be positive.");
+    if (point_set.size() + segments.size() >=
+        std::numeric_limits<index>::max())
+      throw std::length_error("Too many items for UniformGrid");
+
+    points.reserve(point_set.size());
+    for (const point &p : point_set)
+      points.push_back(p);
+
+    bool any = false;
+    real min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+    auto extend = [&](const point &p) {
+      real x = static_cast<real>(p[0]), y = static_cast<real>(p[1]);
+      min_x = any ? std::min(min_x, x) : x;
+      min_y = any ? std::min(min_y, y) : y;
+      max_x = any ? std::max(max_x, x) : x;
+      max_y = any ? std::max(max_y, y) : y;
+      any = true;
+    };
+    for (const point &p : point_set)
+      extend(p);
+    for (const line &s : segments) {
+      extend(s.get_start());
+      extend(s.get_end());
+    }
+
+    origin_x = min_x;
+    origin_y = min_y;
+    real span_columns = std::floor((max_x - min_x) / cell_size) + 1;
+    real span_rows = std::floor((max_y - min_y) / cell_size) + 1;
+    if (span_columns * span_rows > static_cast<real>(max_cells))
+      throw std::invalid_argument(
+          "Grid cell size is too small for the extent of the data.");
+    columns = static_cast<size_t>(span_columns);
+    rows = static_cast<size_t>(span_rows);
+
+    const T *xs = points.axis_data(0);
+    const T *ys = points.axis_data(1);
+    point_table = build_table(
+        points.size(),
+        [&](size_t i, auto &&visit) {
+          visit(row_of(static_cast<real>(ys[i])) * columns +
+                column_of(static_cast<real>(xs[i])));
+        },
+        threads);
+    segment_table = build_table(
+        segments.size(),
+        [&](size_t i, auto &&visit) { rasterize(segments[i], visit); },
+        threads);
+  }
+
+  UniformGrid(std::span<const point> point_set, real size,
+              size_t threads = 1)
+      : UniformGrid(point_set, {}, size, threads) {}
+
+  UniformGrid(std::span<const line> segment_set, real size,
+              size_t threads = 1)
+      : UniformGrid({}, segment_set, size, threads) {}
+
+  real get_cell_size() const { return cell_size; }
+  size_t get_columns() const { return columns; }
+  size_t get_rows() const { return rows; }
+  size_t point_count() const { return points.size(); }
+  size_t segment_count() const { return segments.size(); }
+
+  // Indices of the points inside the closed box, ascending.
+  std::vector<size_t> points_in_box(const box &area) const {
+    std::vector<size_t> result;
+    for_cells_in(static_cast<real>(area.lower[0]),
+                 static_cast<real>(area.lower[1]),
+                 static_cast<real>(area.upper[0]),
+                 static_cast<real>(area.upper[1]), [&](size_t c) {
+                   for (index i : point_table.cell(c))
+                     if (area.contains(points.get_point(i)))
+                       result.push_back(i);
+                 });
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  // Indices of the points with |p - center| <= radius, ascending.
+  std::vector<size_t> points_within_radius(const point &center,
+                                           real radius) const {
+    std::vector<size_t> result;
+    if (radius < 0)
+      return result;
+    real cx = static_cast<real>(center[0]), cy = static_cast<real>(center[1]);
+    real limit = radius * radius;
+    const T *xs = points.axis_data(0);
+    const T *ys = points.axis_data(1);
+    for_cells_in(cx - radius, cy - radius, cx + radius, cy + radius,
+                 [&](size_t c) {
+                   for (index i : point_table.cell(c)) {
+                     real dx = static_cast<real>(xs[i]) - cx;
+                     real dy = static_cast<real>(ys[i]) - cy;
+                     if (dx * dx + dy * dy <= limit)
+                       result.push_back(i);
+                   }
+                 });
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  // Indices of the segments touching the closed box, ascending.
+  std::vector<size_t> segments_in_box(const box &area) const {
+    std::vector<size_t> result;
+    for_cells_in(static_cast<real>(area.lower[0]),
+                 static_cast<real>(area.lower[1]),
+                 static_cast<real>(area.upper[0]),
+                 static_cast<real>(area.upper[1]), [&](size_t c) {
+                   for (index i : segment_table.cell(c))
+                     if (area.intersects(segments[i]))
+                       result.push_back(i);
+                 });
+    sort_unique(result);
+    return result;
+  }
+
+  // Indices of the segments passing within radius of center, ascending.
+  std::vector<size_t> segments_within_radius(const point &center,
+                                             real radius) const {
+    std::vector<size_t> result;
+    if (radius < 0)
+      return result;
+    real cx = static_cast<real>(center[0]), cy = static_cast<real>(center[1]);
+    for_cells_in(cx - radius, cy - radius, cx + radius, cy + radius,
+                 [&](size_t c) {
+                   for (index i : segment_table.cell(c))
+                     if (detail::segment_squared_distance<real>(
+                             center, segments[i]) <= radius * radius)
+                       result.push_back(i);
+                 });
+    sort_unique(result);
+    return result;
+  }
+
+  // Pairs (i, j), i < j, of segments that share at least one cell: a
+  // superset of the intersecting pairs. Sorted and free of duplicates.
+  std::vector<std::pair<size_t, size_t>>
+  segment_candidate_pairs(size_t threads = 1) const {
+    std::vector<std::vector<std::pair<size_t, size_t>>> partial;
+    std::mutex partial_mutex;
+    parallel_for(
+        0, columns * rows, parallel_grain,
+        [&](size_t begin, size_t end) {
+          std::vector<std::pair<size_t, size_t>> local;
+          for (size_t c = begin; c < end; ++c) {
+            auto items = segment_table.cell(c);
+            for (size_t a = 0; a < items.size(); ++a)
+              for (size_t b = a + 1; b < items.size(); ++b)
+                local.emplace_back(items[a], items[b]);
+          }
+          std::lock_guard<std::mutex> lock(partial_mutex);
+          partial.push_back(std::move(local));
+        },
+        threads);
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (auto &chunk : partial)
+      pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+    parallel_sort(pairs.begin(), pairs.end(), std::less<>{}, threads);
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    return pairs;
+  }
+
+  // Pairs (i, j), i < j, of points at most radius apart, sorted.
+  std::vector<std::pair<size_t, size_t>>
+  point_pairs_within(real radius, size_t threads = 1) const {
+    std::vector<std::vector<std::pair<size_t, size_t>>> partial;
+    std::mutex partial_mutex;
+    if (radius < 0)
+      return {};
+    real limit = radius * radius;
+    const T *xs = points.axis_data(0);
+    const T *ys = points.axis_data(1);
+    parallel_for(
+        0, points.size(), parallel_grain,
+        [&](size_t begin, size_t end) {
+          std::vector<std::pair<size_t, size_t>> local;
+          for (size_t i = begin; i < end; ++i) {
+            real x = static_cast<real>(xs[i]), y = static_cast<real>(ys[i]);
+            for_cells_in(x - radius, y - radius, x + radius, y + radius,
+                         [&](size_t c) {
+                           for (index j : point_table.cell(c)) {
+                             if (j <= i)
+                               continue;
+                             real dx = static_cast<real>(xs[j]) - x;
+                             real dy = static_cast<real>(ys[j]) - y;
+                             if (dx * dx + dy * dy <= limit)
+                               local.emplace_back(i, j);
+                           }
+                         });
+          }
+          std::lock_guard<std::mutex> lock(partial_mutex);
+          partial.push_back(std::move(local));
+        },
+        threads);
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (auto &chunk : partial)
+      pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+    parallel_sort(pairs.begin(), pairs.end(), std::less<>{}, threads);
+    return pairs;
+  }
+};
+
+} // namespace GeomCPP
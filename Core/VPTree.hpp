@@ -0,0 +1,271 @@
+#pragma once
+#include "./Parallel.hpp"
+#include "./Point.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GeomCPP {
+
+// Vantage-point tree for exact Euclidean metric search, meant for
+// dimensions where KD-tree pruning stops working. The layout is implicit:
+// a node owns a contiguous range of the reordered points, its vantage point
+// is the first one, the points closer than the median distance follow and
+// the farther ones come last. For every node the distance range of each
+// half to the vantage point is kept in flat arrays indexed by the vantage
+// slot, so the triangle inequality prunes a half without touching it.
+template <typename T, size_t Dim>
+  requires point_numeric<T>
+class VPTree {
+public:
+  using point = Point<T, Dim>;
+  using real = std::conditional_t<std::is_floating_point_v<accumulate_t<T>>,
+                                  accumulate_t<T>, double>;
+
+  struct neighbour {
+    size_t index; // position in the input the tree was built from
+    real distance;
+
+    bool operator<(const neighbour &other) const {
+      return distance < other.distance;
+    }
+  };
+
+  static constexpr size_t leaf_size = 8;
+  // Queries handed to one thread at a time by the batched overloads.
+  static constexpr size_t parallel_grain = 16;
+
+private:
+  using index = std::uint32_t;
+
+  std::vector<point> items;   // tree order
+  std::vector<index> indices; // tree order -> input index
+  // Per vantage slot: distance ranges of the near and far halves.
+  std::vector<real> near_low, near_high, far_low, far_high;
+
+  // Rounding in the accumulated distances is bounded by about Dim ulps of
+  // their size, so lower bounds are shrunk by that much, in absolute terms,
+  // to keep the search exact.
+  static constexpr real slack =
+      static_cast<real>(Dim + 4) * std::numeric_limits<real>::epsilon();
+
+  // Point::distance where it already returns real; integer coordinates are
+  // widened so pruning never sees truncated distances.
+  static real metric(const point &a, const point &b) {
+    if constexpr (std::is_same_v<real, typename point::accumulator>) {
+      return a.distance(b);
+    } else {
+      real sum = 0;
+      for (size_t d = 0; d < Dim; ++d) {
+        real diff = static_cast<real>(a[d]) - static_cast<real>(b[d]);
+        sum += diff * diff;
+      }
+      return std::sqrt(sum);
+    }
+  }
+
+  static constexpr size_t split(size_t lo, size_t hi) {
+    return lo + 1 + (hi - lo - 1) / 2;
+  }
+
+  static real lower_bound(real distance, real low, real high) {
+    real gap = std::max({low - distance, distance - high, real{0}});
+    real margin =
+        slack * (distance + std::max(std::abs(low), std::abs(high)));
+    return std::max(gap - margin, real{0});
+  }
+
+  void build(const std::vector<point> &input, size_t threads) {
+    size_t count = input.size();
+    std::vector<std::pair<real, index>> work(count);
+    for (size_t i = 0; i < count; ++i)
+      work[i] = {0, static_cast<index>(i)};
+    near_low.assign(count, 0);
+    near_high.assign(count, 0);
+    far_low.assign(count, 0);
+    far_high.assign(count, 0);
+
+    struct range {
+      size_t lo, hi;
+    };
+    std::vector<range> level;
+    if (count > leaf_size)
+      level.push_back({0, count});
+
+    while (!level.empty()) {
+      parallel_for(
+          0, level.size(), 1,
+          [&](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r)
+              partition(input, work, level[r].lo, level[r].hi);
+          },
+          threads);
+
+      std::vector<range> next;
+      for (auto [lo, hi] : level) {
+        size_t mid = split(lo, hi);
+        if (mid - lo - 1 > leaf_size)
+          next.push_back({lo + 1, mid});
+        if (hi - mid > leaf_size)
+          next.push_back({mid, hi});
+      }
+      level = std::move(next);
+    }
+
+    indices.resize(count);
+    items.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      indices[i] = work[i].second;
+      items.push_back(input[work[i].second]);
+    }
+  }
+
+  // Picks a vantage point for [lo, hi), moves it to lo and splits the rest
+  // at the median distance.
+  void partition(const std::vector<point> &input,
+                 std::vector<std::pair<real, index>> &work, size_t lo,
+                 size_t hi) {
+    // Deterministic pseudo-random vantage choice.
+    size_t pick = lo + (lo * 2654435761u + hi) % (hi - lo);
+    std::swap(work[lo], work[pick]);
+    const point &vantage = input[work[lo].second];
+    for (size_t i = lo + 1; i < hi; ++i)
+      work[i].first = metric(vantage, input[work[i].second]);
+
+    size_t mid = split(lo, hi);
+    std::nth_element(work.begin() + lo + 1, work.begin() + mid,
+                     work.begin() + hi);
+
+    auto [near_min, near_max] = std::minmax_element(
+        work.begin() + lo + 1, work.begin() + mid);
+    auto [far_min, far_max] =
+        std::minmax_element(work.begin() + mid, work.begin() + hi);
+    near_low[lo] = near_min->first;
+    near_high[lo] = near_max->first;
+    far_low[lo] = far_min->first;
+    far_high[lo] = far_max->first;
+  }
+
+  // visit(slot, distance) sees every candidate; radius() is the current
+  // search radius.
+  template <typename Visit, typename Radius>
+  void descend(size_t lo, size_t hi, const point &query, Visit &visit,
+               Radius &radius) const {
+    if (hi - lo <= leaf_size) {
+      for (size_t slot = lo; slot < hi; ++slot)
+        visit(slot, metric(query, items[slot]));
+      return;
+    }
+
+    real distance = metric(query, items[lo]);
+    visit(lo, distance);
+
+    size_t mid = split(lo, hi);
+    real near_bound = lower_bound(distance, near_low[lo], near_high[lo]);
+    real far_bound = lower_bound(distance, far_low[lo], far_high[lo]);
+    if (near_bound <= far_bound) {
+      if (near_bound <= radius())
+        descend(lo + 1, mid, query, visit, radius);
+      if (far_bound <= radius())
+        descend(mid, hi, query, visit, radius);
+    } else {
+      if (far_bound <= radius())
+        descend(mid, hi, query, visit, radius);
+      if (near_bound <= radius())
+        descend(lo + 1, mid, query, visit, radius);
+    }
+  }
+
+public:
+  VPTree() = default;
+
+  // threads == 0 uses every hardware thread for the build.
+  explicit VPTree(const std::vector<point> &points, size_t threads = 1) {
+    if (points.size() >= std::numeric_limits<index>::max())
+      throw std::length_error("Too many points for VPTree");
+    build(points, threads);
+  }
+
+  size_t size() const { return items.size(); }
+  bool empty() const { return items.empty(); }
+
+  // The k closest points, nearest first.
+  std::vector<neighbour> nearest(const point &query, size_t k) const {
+    std::vector<neighbour> heap;
+    if (k == 0 || empty())
+      return heap;
+    heap.reserve(k + 1);
+
+    auto visit = [&](size_t slot, real distance) {
+      if (heap.size() < k) {
+        heap.push_back({indices[slot], distance});
+        std::push_heap(heap.begin(), heap.end());
+      } else if (distance < heap.front().distance) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = {indices[slot], distance};
+        std::push_heap(heap.begin(), heap.end());
+      }
+    };
+    auto radius = [&] {
+      return heap.size() < k ? std::numeric_limits<real>::infinity()
+                             : heap.front().distance;
+    };
+    descend(0, size(), query, visit, radius);
+
+    std::sort_heap(heap.begin(), heap.end());
+    return heap;
+  }
+
+  // Every point with distance <= radius, in no particular order.
+  std::vector<neighbour> within_radius(const point &query,
+                                       real radius) const {
+    std::vector<neighbour> result;
+    if (empty() || radius < 0)
+      return result;
+    auto visit = [&](size_t slot, real distance) {
+      if (distance <= radius)
+        result.push_back({indices[slot], distance});
+    };
+    auto limit = [&] { return radius; };
+    descend(0, size(), query, visit, limit);
+    return result;
+  }
+
+  // Batched queries; threads == 0 uses every hardware thread.
+  std::vector<std::vector<neighbour>> nearest(std::span<const point> queries,
+                                              size_t k,
+                                              size_t threads = 0) const {
+    std::vector<std::vector<neighbour>> results(queries.size());
+    parallel_for(
+        0, queries.size(), parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t q = begin; q < end; ++q)
+            results[q] = nearest(queries[q], k);
+        },
+        threads);
+    return results;
+  }
+
+  std::vector<std::vector<neighbour>>
+  within_radius(std::span<const point> queries, real radius,
+                size_t threads = 0) const {
+    std::vector<std::vector<neighbour>> results(queries.size());
+    parallel_for(
+        0, queries.size(), parallel_grain,
+        [&](size_t begin, size_t end) {
+          for (size_t q = begin; q < end; ++q)
+            results[q] = within_radius(queries[q], radius);
+        },
+        threads);
+    return results;
+  }
+};
+
+} // namespace GeomCPP
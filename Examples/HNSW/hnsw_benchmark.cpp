@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+#include "../../Core/HNSW.hpp"
+
+namespace gp = GeomCPP;
+
+// Recall@k and mean query latency of HNSW at several efSearch values,
+// against the brute-force scan over the same points.
+//
+// Usage: hnsw_benchmark [points] [queries] [threads]
+
+constexpr size_t Dim = 128;
+using Vector = gp::Point<float, Dim>;
+using Clock = std::chrono::steady_clock;
+
+std::vector<Vector> random_vectors(size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> coord(0.0f, 1.0f);
+    std::vector<Vector> vectors;
+    vectors.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::array<float, Dim> coords;
+        for (auto &c : coords)
+            c = coord(rng);
+        vectors.emplace_back(coords);
+    }
+    return vectors;
+}
+
+double microseconds_since(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start)
+        .count();
+}
+
+int main(int argc, char **argv)
+{
+    size_t point_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t query_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+    size_t threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 0;
+    const size_t k = 10;
+
+    auto points = random_vectors(point_count, 1);
+    auto queries = random_vectors(query_count, 2);
+
+    gp::HNSW<float, Dim> index;
+    auto start = Clock::now();
+    index.add(std::span<const Vector>(points), threads);
+    std::cout << "Built " << point_count << " x " << Dim << " in "
+              << microseconds_since(start) / 1e6 << " s\n";
+
+    std::vector<std::set<size_t>> truth(query_count);
+    start = Clock::now();
+    for (size_t q = 0; q < query_count; ++q)
+        for (const auto &n : index.brute_force_search(queries[q], k))
+            truth[q].insert(n.index);
+    double brute_latency = microseconds_since(start) / query_count;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "brute force: recall 1.000, " << brute_latency
+              << " us/query\n";
+    for (size_t ef : {10, 20, 40, 80, 160, 320})
+    {
+        size_t hits = 0;
+        start = Clock::now();
+        for (size_t q = 0; q < query_count; ++q)
+            for (const auto &n : index.search(queries[q], k, ef))
+                hits += truth[q].count(n.index);
+        double latency = microseconds_since(start) / query_count;
+        std::cout << "ef " << std::setw(3) << ef << ": recall "
+                  << static_cast<double>(hits) / (query_count * k) << ", "
+                  << latency << " us/query, "
+                  << brute_latency / latency << "x faster\n";
+    }
+    return 0;
+}
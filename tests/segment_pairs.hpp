@@ -0,0 +1,43 @@
+#pragma once
+#include "../Core/Line.hpp"
+#include <random>
+#include <utility>
+#include <vector>
+
+// Reference helpers shared by the segment-intersection tests.
+namespace GeomCPP::test_support {
+
+template <typename T>
+std::vector<std::pair<size_t, size_t>>
+brute_force_pairs(const std::vector<Line<T, 2>> &lines) {
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t i = 0; i < lines.size(); ++i)
+    for (size_t j = i + 1; j < lines.size(); ++j)
+      if (lines[i].intersects(lines[j]))
+        pairs.emplace_back(i, j);
+  return pairs;
+}
+
+// Segments between random points of a (size + 1) x (size + 1) lattice with
+// spacing (x_step, y_step), so shared endpoints, T-junctions, verticals,
+// collinear overlaps and several segments crossing at one point are common.
+// Inexact steps such as 0.1 turn those into near-degenerate cases instead.
+template <typename T>
+std::vector<Line<T, 2>> lattice_segments(size_t count, int size, unsigned seed,
+                                         T x_step = 1, T y_step = 1) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> coord(0, size);
+  auto lattice_point = [&] {
+    return Point<T, 2>({static_cast<T>(static_cast<T>(coord(rng)) * x_step),
+                        static_cast<T>(static_cast<T>(coord(rng)) * y_step)});
+  };
+  std::vector<Line<T, 2>> lines;
+  while (lines.size() < count) {
+    Point<T, 2> a = lattice_point(), b = lattice_point();
+    if (!(a == b))
+      lines.emplace_back(a, b);
+  }
+  return lines;
+}
+
+} // namespace GeomCPP::test_support
@@ -0,0 +1,137 @@
+#include "../Core/BatchIntersections.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+// Checks lane i against Line::intersects and, for hits, that the point is
+// where both parameters put it.
+template <typename T, typename Real>
+void expect_lane(const Line<T, 2> &first, const Line<T, 2> &second,
+                 const segment_intersection_buffers<Real> &out, size_t i,
+                 double tolerance) {
+  bool expected = first.intersects(second);
+  ASSERT_EQ(out.hits[i], expected ? 1 : 0) << "at " << i;
+  if (!expected) {
+    EXPECT_EQ(out.t[i], 0);
+    EXPECT_EQ(out.x[i], 0);
+    return;
+  }
+  EXPECT_GE(out.t[i], 0);
+  EXPECT_LE(out.t[i], 1);
+  EXPECT_GE(out.u[i], 0);
+  EXPECT_LE(out.u[i], 1);
+  auto a = first.get_start(), b = first.get_end();
+  auto c = second.get_start(), d = second.get_end();
+  double t = out.t[i], u = out.u[i];
+  EXPECT_NEAR(out.x[i], a[0] + t * (b[0] - a[0]), tolerance);
+  EXPECT_NEAR(out.y[i], a[1] + t * (b[1] - a[1]), tolerance);
+  EXPECT_NEAR(out.x[i], c[0] + u * (d[0] - c[0]), tolerance);
+  EXPECT_NEAR(out.y[i], c[1] + u * (d[1] - c[1]), tolerance);
+}
+} // namespace
+
+TEST(BatchIntersectionsTest, OneAgainstManyMatchesLineIntersects) {
+  std::mt19937 rng(8);
+  std::uniform_real_distribution<double> coord(-10.0, 10.0);
+  Line<double, 2> segment(Point<double, 2>({-8.0, -3.0}),
+                          Point<double, 2>({9.0, 4.0}));
+
+  PointCloud<double, 2> starts, ends;
+  std::vector<Line<double, 2>> others;
+  auto add = [&](Point<double, 2> c, Point<double, 2> d) {
+    starts.push_back(c);
+    ends.push_back(d);
+    others.emplace_back(c, d);
+  };
+  for (int i = 0; i < 1000; ++i)
+    add(Point<double, 2>({coord(rng), coord(rng)}),
+        Point<double, 2>({coord(rng), coord(rng)}));
+  // Touching at an endpoint, ending on the segment, parallel, collinear.
+  add(Point<double, 2>({9.0, 4.0}), Point<double, 2>({9.0, 10.0}));
+  add(Point<double, 2>({0.5, 0.5}), Point<double, 2>({0.5, 5.0}));
+  add(Point<double, 2>({-8.0, -2.0}), Point<double, 2>({9.0, 5.0}));
+  add(Point<double, 2>({-25.0, -10.0}), Point<double, 2>({26.0, 11.0}));
+
+  std::vector<std::uint8_t> hits(starts.size());
+  std::vector<double> t(starts.size()), u(starts.size()), x(starts.size()),
+      y(starts.size());
+  segment_intersection_buffers<double> out{hits, t, u, x, y};
+  intersect_segments(segment, starts, ends, out);
+  size_t hit_count = 0;
+  for (size_t i = 0; i < others.size(); ++i) {
+    expect_lane(segment, others[i], out, i, 1e-9);
+    hit_count += out.hits[i];
+  }
+  EXPECT_GT(hit_count, 100u);
+  EXPECT_EQ(out.hits[1000], 1);
+  EXPECT_DOUBLE_EQ(out.t[1000], 1.0);
+  EXPECT_EQ(out.hits[1001], 1);
+  EXPECT_DOUBLE_EQ(out.u[1001], 0.0);
+  EXPECT_EQ(out.hits[1002], 0);
+  EXPECT_EQ(out.hits[1003], 0);
+}
+
+TEST(BatchIntersectionsTest, PairsMatchLineIntersectsOnDegenerateInput) {
+  // Lattice segments: shared endpoints, T-junctions and collinear pairs.
+  std::mt19937 rng(9);
+  std::uniform_int_distribution<int> coord(0, 4);
+  auto lattice_point = [&] {
+    return Point<int, 2>({coord(rng), coord(rng)});
+  };
+  PointCloud<int, 2> a0, a1, b0, b1;
+  PointCloud<float, 2> fa0, fa1, fb0, fb1;
+  std::vector<Line<int, 2>> first, second;
+  auto as_float = [](const Point<int, 2> &p) {
+    return Point<float, 2>(
+        {static_cast<float>(p[0]), static_cast<float>(p[1])});
+  };
+  while (first.size() < 2000) {
+    auto p = lattice_point(), q = lattice_point();
+    auto r = lattice_point(), s = lattice_point();
+    if (p == q || r == s)
+      continue;
+    first.emplace_back(p, q);
+    second.emplace_back(r, s);
+    a0.push_back(p);
+    a1.push_back(q);
+    b0.push_back(r);
+    b1.push_back(s);
+    fa0.push_back(as_float(p));
+    fa1.push_back(as_float(q));
+    fb0.push_back(as_float(r));
+    fb1.push_back(as_float(s));
+  }
+
+  size_t n = first.size();
+  std::vector<std::uint8_t> exact_hits(n), filtered_hits(n);
+  std::vector<double> t(n), u(n), x(n), y(n);
+  std::vector<float> ft(n), fu(n), fx(n), fy(n);
+  segment_intersection_buffers<double> exact{exact_hits, t, u, x, y};
+  segment_intersection_buffers<float> filtered{filtered_hits, ft, fu, fx, fy};
+  intersect_segments(a0, a1, b0, b1, exact);
+  intersect_segments(fa0, fa1, fb0, fb1, filtered);
+  for (size_t i = 0; i < first.size(); ++i) {
+    expect_lane(first[i], second[i], exact, i, 1e-9);
+    expect_lane(first[i], second[i], filtered, i, 1e-5);
+  }
+}
+
+TEST(BatchIntersectionsTest, RejectsMismatchedSizes) {
+  PointCloud<double, 2> starts, ends;
+  starts.push_back(Point<double, 2>({0.0, 0.0}));
+  ends.push_back(Point<double, 2>({1.0, 1.0}));
+  Line<double, 2> segment(Point<double, 2>({0.0, 1.0}),
+                          Point<double, 2>({1.0, 0.0}));
+  std::vector<std::uint8_t> hits(2);
+  std::vector<double> t(2), u(2), x(2), y(2);
+  EXPECT_THROW(intersect_segments(segment, starts, ends, {hits, t, u, x, y}),
+               std::invalid_argument);
+  ends.push_back(Point<double, 2>({2.0, 2.0}));
+  EXPECT_THROW(intersect_segments(segment, starts, ends, {hits, t, u, x, y}),
+               std::invalid_argument);
+}
@@ -0,0 +1,95 @@
+#include "../Core/BatchPredicates.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace GeomCPP;
+
+TEST(BatchPredicatesTest, FixedSegmentMatchesScalarPredicate) {
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> coord(-100.0, 100.0);
+  Point<double, 2> a({-3.0, 1.5}), b({7.0, -2.0});
+
+  PointCloud<double, 2> points;
+  for (int i = 0; i < 1000; ++i)
+    points.push_back(Point<double, 2>({coord(rng), coord(rng)}));
+  // Points exactly on the line and a few one-ulp perturbations of them.
+  for (int i = 0; i < 37; ++i) {
+    double t = i / 8.0;
+    double x = -3.0 + 10.0 * t, y = 1.5 - 3.5 * t;
+    points.push_back(Point<double, 2>({x, y}));
+    points.push_back(Point<double, 2>({x, std::nextafter(y, 1e9)}));
+  }
+
+  std::vector<std::int8_t> signs(points.size());
+  orientation_signs(a, b, points, std::span<std::int8_t>(signs));
+  for (size_t i = 0; i < points.size(); ++i) {
+    Point<double, 2> p = points[i];
+    EXPECT_EQ(signs[i], orientation_sign(a[0], a[1], b[0], b[1], p[0], p[1]))
+        << "at " << i;
+  }
+}
+
+TEST(BatchPredicatesTest, NearCollinearGridIsExact) {
+  // Shewchuk's grid: the filter rejects most lanes and the fallback decides.
+  Point<double, 2> b({12.0, 12.0}), c({24.0, 24.0});
+  std::vector<double> xs, ys;
+  for (int i = 0; i < 64; ++i)
+    for (int j = 0; j < 64; ++j) {
+      xs.push_back(0.5 + i * 0x1p-53);
+      ys.push_back(0.5 + j * 0x1p-53);
+    }
+
+  std::vector<std::int8_t> signs(xs.size());
+  orientation_signs(b, c, std::span<const double>(xs),
+                    std::span<const double>(ys),
+                    std::span<std::int8_t>(signs));
+  for (size_t i = 0; i < xs.size(); ++i)
+    EXPECT_EQ(signs[i], (ys[i] > xs[i]) - (ys[i] < xs[i]));
+}
+
+TEST(BatchPredicatesTest, TripletsMatchScalarPredicate) {
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> coord(-1.0f, 1.0f);
+  PointCloud<float, 2> a, b, c;
+  for (int i = 0; i < 500; ++i) {
+    a.push_back(Point<float, 2>({coord(rng), coord(rng)}));
+    b.push_back(Point<float, 2>({coord(rng), coord(rng)}));
+    // Every other c sits on the segment's midpoint, i.e. on the line.
+    if (i % 2 == 0)
+      c.push_back(Point<float, 2>({coord(rng), coord(rng)}));
+    else
+      c.push_back(Point<float, 2>({(a[i][0] + b[i][0]) / 2,
+                                   (a[i][1] + b[i][1]) / 2}));
+  }
+
+  std::vector<std::int8_t> signs(a.size());
+  orientation_signs(a, b, c, std::span<std::int8_t>(signs));
+  for (size_t i = 0; i < a.size(); ++i)
+    EXPECT_EQ(signs[i], orientation_sign(a[i][0], a[i][1], b[i][0], b[i][1],
+                                         c[i][0], c[i][1]));
+}
+
+TEST(BatchPredicatesTest, IntegerCoordinatesUseExactPath) {
+  const std::int64_t big = std::int64_t{1} << 60;
+  Point<std::int64_t, 2> a({0, 0}), b({big, big - 1});
+  PointCloud<std::int64_t, 2> points;
+  points.push_back(Point<std::int64_t, 2>({big, big}));
+  points.push_back(Point<std::int64_t, 2>({big, big - 2}));
+  points.push_back(Point<std::int64_t, 2>({2 * big, 2 * big - 2}));
+
+  std::vector<std::int8_t> signs(points.size());
+  orientation_signs(a, b, points, std::span<std::int8_t>(signs));
+  EXPECT_EQ(signs, (std::vector<std::int8_t>{1, -1, 0}));
+  EXPECT_EQ(collinear(a, b, points), (std::vector<bool>{false, false, true}));
+}
+
+TEST(BatchPredicatesTest, ThrowsOnMismatchedSizes) {
+  PointCloud<double, 2> a(4), b(4), c(3);
+  std::vector<std::int8_t> signs(4);
+  EXPECT_THROW(orientation_signs(a, b, c, std::span<std::int8_t>(signs)),
+               std::invalid_argument);
+  EXPECT_THROW(orientation_signs(a[0], b[0], c,
+                                 std::span<std::int8_t>(signs)),
+               std::invalid_argument);
+}
@@ -0,0 +1,88 @@
+#include "../Core/BatchProjections.hpp"
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace GeomCPP;
+
+TEST(BatchProjectionsTest, MatchesPreparedLineQueries) {
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> coord(-5.0, 5.0);
+  PreparedLine<double, 2> segment(Point<double, 2>({-3.0, 1.0}),
+                                  Point<double, 2>({4.0, -2.0}));
+
+  // Random points, points on the segment and points just off it.
+  PointCloud<double, 2> points;
+  for (int i = 0; i < 300; ++i)
+    points.push_back(Point<double, 2>({coord(rng), coord(rng)}));
+  for (int i = 0; i <= 20; ++i) {
+    double s = i / 20.0;
+    points.push_back(Point<double, 2>({-3.0 + 7.0 * s, 1.0 - 3.0 * s}));
+    points.push_back(Point<double, 2>({-3.0 + 7.0 * s, 1.0 - 3.0 * s + 1e-6}));
+  }
+  points.push_back(Point<double, 2>({4.0 + 7e-3, -2.0 - 3e-3}));
+
+  std::vector<std::uint8_t> on(points.size());
+  std::vector<double> t(points.size()), distance(points.size());
+  classify_points(segment, points, {on, t, distance});
+  double length = std::sqrt(58.0);
+  for (size_t i = 0; i < points.size(); ++i) {
+    Point<double, 2> p = points[i];
+    ASSERT_EQ(on[i], segment.contains(p) ? 1 : 0) << "at " << i;
+    EXPECT_NEAR(t[i], segment.parameter(p), 1e-12);
+    double cross = 7.0 * (p[1] - 1.0) + 3.0 * (p[0] + 3.0);
+    EXPECT_NEAR(distance[i], cross / length, 1e-12);
+  }
+  EXPECT_EQ(on[300], 1);
+  EXPECT_EQ(on[301], 0);
+  EXPECT_EQ(on.back(), 0);
+}
+
+TEST(BatchProjectionsTest, SnapsWithinDistance) {
+  using Point2F = Point<float, 2>;
+  Line<float, 2> road(Point2F({0.0f, 0.0f}), Point2F({10.0f, 0.0f}));
+  PointCloud<float, 2> fixes;
+  fixes.push_back(Point2F({2.0f, 0.5f}));
+  fixes.push_back(Point2F({7.5f, -0.9f}));
+  fixes.push_back(Point2F({5.0f, 1.5f}));
+  fixes.push_back(Point2F({-0.5f, 0.0f}));
+  fixes.push_back(Point2F({10.0f, 1.0f}));
+
+  std::vector<std::uint8_t> on(fixes.size());
+  std::vector<float> t(fixes.size()), distance(fixes.size());
+  classify_points(road, fixes, {on, t, distance}, 1.0f);
+  EXPECT_EQ(on, (std::vector<std::uint8_t>{1, 1, 0, 0, 1}));
+  EXPECT_FLOAT_EQ(t[1], 0.75f);
+  EXPECT_FLOAT_EQ(distance[1], -0.9f);
+  EXPECT_FLOAT_EQ(t[3], -0.05f);
+  EXPECT_FLOAT_EQ(distance[2], 1.5f);
+}
+
+TEST(BatchProjectionsTest, IntegerCoordinates) {
+  using Point2I = Point<int, 2>;
+  Line<int, 2> line(Point2I({1, 2}), Point2I({9, 6}));
+  PointCloud<int, 2> points;
+  for (int x = 0; x <= 10; ++x)
+    for (int y = 0; y <= 8; ++y)
+      points.push_back(Point2I({x, y}));
+
+  std::vector<std::uint8_t> on(points.size());
+  std::vector<double> t(points.size()), distance(points.size());
+  classify_points(line, points, {on, t, distance});
+  for (size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(on[i], line.contains(points[i]) ? 1 : 0) << "at " << i;
+}
+
+TEST(BatchProjectionsTest, RejectsMismatchedSizes) {
+  Line<double, 2> line(Point<double, 2>({0.0, 0.0}),
+                       Point<double, 2>({1.0, 1.0}));
+  PointCloud<double, 2> points;
+  points.push_back(Point<double, 2>({0.5, 0.5}));
+  std::vector<std::uint8_t> on(2);
+  std::vector<double> t(2), distance(2);
+  EXPECT_THROW(classify_points(line, points, {on, t, distance}),
+               std::invalid_argument);
+}
@@ -0,0 +1,82 @@
+#include "../Core/DistanceMatrix.hpp"
+#include <gtest/gtest.h>
+
+using namespace GeomCPP;
+
+using Point3D = Point<double, 3>;
+
+static std::vector<Point3D> make_points(size_t count, double seed) {
+  std::vector<Point3D> points;
+  for (size_t i = 0; i < count; ++i)
+    points.push_back(Point3D({std::sin(seed * i), std::cos(seed + i) * 3.0,
+                              static_cast<double>(i % 7)}));
+  return points;
+}
+
+TEST(DistanceMatrixTest, MatchesPointDistance) {
+  auto rows = make_points(70, 0.3);
+  auto cols = make_points(600, 1.7);
+  std::vector<double> out(rows.size() * cols.size());
+
+  distance_matrix(rows, cols, out);
+
+  for (size_t i = 0; i < rows.size(); ++i)
+    for (size_t j = 0; j < cols.size(); ++j)
+      EXPECT_NEAR(out[i * cols.size() + j], rows[i].distance(cols[j]), 1e-12);
+}
+
+TEST(DistanceMatrixTest, SquaredModeSkipsSqrt) {
+  auto rows = make_points(40, 0.9);
+  auto cols = make_points(33, 2.1);
+  std::vector<double> out(rows.size() * cols.size());
+
+  distance_matrix(rows, cols, out, distance_mode::squared, 3);
+
+  for (size_t i = 0; i < rows.size(); ++i)
+    for (size_t j = 0; j < cols.size(); ++j) {
+      double dist = rows[i].distance(cols[j]);
+      EXPECT_NEAR(out[i * cols.size() + j], dist * dist, 1e-9);
+    }
+}
+
+TEST(DistanceMatrixTest, HalfStorageAccumulatesInFloat) {
+  // Each squared difference overflows binary16; the float sum does not.
+  using HalfPoint = Point<float16, 4>;
+  std::vector<HalfPoint> rows{HalfPoint({300.0f, 300.0f, 300.0f, 300.0f}),
+                              HalfPoint({1.0f, 2.0f, 3.0f, 4.0f})};
+  std::vector<HalfPoint> cols{HalfPoint({0.0f, 0.0f, 0.0f, 0.0f})};
+  std::vector<float16> out(2);
+
+  distance_matrix(rows, cols, out);
+  EXPECT_EQ(float(out[0]), 600.0f);
+  EXPECT_NEAR(float(out[1]), std::sqrt(30.0f), 1e-2f);
+}
+
+TEST(DistanceMatrixTest, RejectsShortBuffer) {
+  auto rows = make_points(4, 0.5);
+  std::vector<double> out(15);
+  EXPECT_THROW(distance_matrix(rows, rows, out), std::invalid_argument);
+}
+
+TEST(DistanceMatrixTest, HighDimensionUsesNarrowColumnTiles) {
+  using WidePoint = Point<float, 128>;
+  static_assert(detail::distance_col_width<float, 128> * 128 * sizeof(float) <=
+                detail::distance_l1_budget);
+  static_assert(detail::distance_col_width<double, 3> ==
+                detail::distance_col_tile);
+
+  std::vector<WidePoint> rows, cols;
+  for (size_t i = 0; i < 50; ++i) {
+    std::array<float, 128> coords{};
+    for (size_t d = 0; d < 128; ++d)
+      coords[d] = std::sin(0.1f * static_cast<float>(i * 128 + d));
+    (i < 5 ? rows : cols).push_back(WidePoint(coords));
+  }
+  std::vector<float> out(rows.size() * cols.size());
+
+  distance_matrix(rows, cols, out);
+
+  for (size_t i = 0; i < rows.size(); ++i)
+    for (size_t j = 0; j < cols.size(); ++j)
+      EXPECT_NEAR(out[i * cols.size() + j], rows[i].distance(cols[j]), 1e-4f);
+}
@@ -0,0 +1,74 @@
+#include "../Core/PointCloud.hpp"
+#include <gtest/gtest.h>
+
+using namespace GeomCPP;
+
+TEST(HalfTest, Float16RoundTripsEveryEncoding) {
+  for (std::uint32_t bits = 0; bits <= 0xFFFF; ++bits) {
+    float16 value = float16::from_bits(static_cast<std::uint16_t>(bits));
+    float widened = value;
+    if (std::isnan(widened))
+      continue;
+    EXPECT_EQ(float16(widened).to_bits(), bits);
+  }
+}
+
+TEST(HalfTest, Float16RoundsToNearestEven) {
+  EXPECT_EQ(float(float16(1.0f)), 1.0f);
+  EXPECT_EQ(float(float16(65504.0f)), 65504.0f);
+  EXPECT_TRUE(std::isinf(float(float16(65520.0f))));
+  // 1 + 2^-11 is halfway between 1 and the next half; ties go to even.
+  EXPECT_EQ(float(float16(1.0f + 0x1p-11f)), 1.0f);
+  EXPECT_EQ(float(float16(1.0f + 0x1p-10f + 0x1p-11f)), 1.0f + 0x1p-9f);
+  EXPECT_EQ(float(float16(0x1p-24f)), 0x1p-24f);
+  EXPECT_EQ(float(float16(0x1p-25f)), 0.0f);
+}
+
+TEST(HalfTest, BFloat16KeepsFloatRange) {
+  float large = bfloat16(3.0e38f);
+  EXPECT_FALSE(std::isinf(large));
+  EXPECT_NEAR(large / 3.0e38f, 1.0f, 0x1p-8f);
+  EXPECT_EQ(float(bfloat16(1.0f)), 1.0f);
+  EXPECT_EQ(float(bfloat16(1.00390625f)), 1.0f);
+  EXPECT_TRUE(std::isnan(float(bfloat16(std::nanf("")))));
+}
+
+TEST(HalfTest, PointStorageAccumulatesInFloat) {
+  using HalfPoint = Point<float16, 4>;
+  static_assert(sizeof(std::array<float16, 4>) == 8);
+  static_assert(std::is_same_v<decltype(HalfPoint({}).dot(HalfPoint({}))),
+                               float>);
+
+  HalfPoint a({1.0f, 2.0f, 3.0f, 4.0f});
+  HalfPoint b({0.5f, 0.5f, 0.5f, 0.5f});
+
+  HalfPoint sum = a + b;
+  EXPECT_EQ(float(sum[3]), 4.5f);
+  EXPECT_FLOAT_EQ(a.dot(b), 5.0f);
+  EXPECT_FLOAT_EQ(a.distance(b), std::sqrt(0.25f + 2.25f + 6.25f + 12.25f));
+
+  a.scale(2);
+  EXPECT_EQ(float(a[0]), 2.0f);
+  EXPECT_TRUE(a == HalfPoint({2.0f, 4.0f, 6.0f, 8.0f}));
+}
+
+TEST(HalfTest, FloatAccumulationAvoidsHalfOverflow) {
+  // Every partial sum exceeds the binary16 range, the float total does not.
+  Point<float16, 4> big({300.0f, 300.0f, 300.0f, 300.0f});
+  EXPECT_FLOAT_EQ(big.dot(big), 360000.0f);
+  EXPECT_FLOAT_EQ(big.magnitude(), 600.0f);
+}
+
+TEST(HalfTest, CloudOfHalfPoints) {
+  using Cloud = PointCloud<bfloat16, 3>;
+  Cloud cloud({Point<bfloat16, 3>({1.0f, 2.0f, 2.0f}),
+               Point<bfloat16, 3>({0.0f, 3.0f, 4.0f})});
+
+  auto dists = cloud.distance(Point<bfloat16, 3>({0.0f, 0.0f, 0.0f}));
+  static_assert(std::is_same_v<decltype(dists), std::vector<float>>);
+  EXPECT_FLOAT_EQ(dists[0], 3.0f);
+  EXPECT_FLOAT_EQ(dists[1], 5.0f);
+
+  auto halved = cloud / bfloat16(2.0f);
+  EXPECT_EQ(float(halved[1][2]), 2.0f);
+}
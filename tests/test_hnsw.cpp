@@ -0,0 +1,152 @@
+#include "../Core/HNSW.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+template <size_t Dim>
+std::vector<Point<float, Dim>> random_points(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> coord(0.0f, 1.0f);
+  std::vector<Point<float, Dim>> points;
+  for (size_t i = 0; i < count; ++i) {
+    std::array<float, Dim> coords;
+    for (auto &c : coords)
+      c = coord(rng);
+    points.emplace_back(coords);
+  }
+  return points;
+}
+
+template <size_t Dim>
+double recall(const HNSW<float, Dim> &index,
+              const std::vector<Point<float, Dim>> &queries, size_t k,
+              size_t ef) {
+  size_t hits = 0;
+  for (const auto &query : queries) {
+    std::set<size_t> truth;
+    for (const auto &n : index.brute_force_search(query, k))
+      truth.insert(n.index);
+    for (const auto &n : index.search(query, k, ef))
+      hits += truth.count(n.index);
+  }
+  return static_cast<double>(hits) / (queries.size() * k);
+}
+} // namespace
+
+TEST(HNSWTest, SerialInsertionReachesHighRecall) {
+  auto points = random_points<32>(2000, 1);
+  HNSW<float, 32> index;
+  for (const auto &p : points)
+    index.add(p);
+  ASSERT_EQ(index.size(), points.size());
+
+  auto queries = random_points<32>(50, 2);
+  EXPECT_GT(recall(index, queries, 10, 100), 0.9);
+
+  auto result = index.search(queries[0], 10);
+  ASSERT_EQ(result.size(), 10u);
+  for (size_t i = 1; i < result.size(); ++i)
+    EXPECT_LE(result[i - 1].squared_distance, result[i].squared_distance);
+}
+
+TEST(HNSWTest, ParallelInsertionReachesHighRecall) {
+  auto points = random_points<64>(3000, 3);
+  HNSW<float, 64>::parameters params;
+  params.M = 12;
+  params.ef_construction = 100;
+  HNSW<float, 64> index(params);
+  index.add(std::span<const Point<float, 64>>(points), 4);
+  ASSERT_EQ(index.size(), points.size());
+
+  auto queries = random_points<64>(50, 4);
+  EXPECT_GT(recall(index, queries, 10, 150), 0.85);
+
+  auto batched =
+      index.search(std::span<const Point<float, 64>>(queries), 5, 64, 3);
+  for (size_t q = 0; q < queries.size(); ++q) {
+    auto single = index.search(queries[q], 5, 64);
+    ASSERT_EQ(batched[q].size(), single.size());
+    for (size_t i = 0; i < single.size(); ++i)
+      EXPECT_EQ(batched[q][i].index, single[i].index);
+  }
+}
+
+TEST(HNSWTest, SavesAndLoadsGraph) {
+  auto points = random_points<16>(500, 5);
+  HNSW<float, 16> index;
+  index.add(std::span<const Point<float, 16>>(points), 2);
+
+  std::string path = ::testing::TempDir() + "geomcpp_hnsw_test.bin";
+  index.save(path);
+  auto loaded = HNSW<float, 16>::load(path);
+  EXPECT_EQ(loaded.size(), index.size());
+  EXPECT_EQ(loaded.get_parameters().M, index.get_parameters().M);
+
+  for (const auto &query : random_points<16>(20, 6)) {
+    auto expected = index.search(query, 5);
+    auto actual = loaded.search(query, 5);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(actual[i].index, expected[i].index);
+      EXPECT_EQ(actual[i].squared_distance, expected[i].squared_distance);
+    }
+  }
+
+  using Narrow = HNSW<float, 8>;
+  using Same = HNSW<float, 16>;
+  EXPECT_THROW(Narrow::load(path), std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(Same::load(path), std::runtime_error);
+}
+
+TEST(HNSWTest, LoadRejectsInconsistentGraph) {
+  using Index = HNSW<float, 4>;
+  Index index;
+  index.add(Point<float, 4>({0, 0, 0, 0}));
+  index.add(Point<float, 4>({1, 1, 1, 1}));
+  std::string path = ::testing::TempDir() + "geomcpp_hnsw_corrupt.bin";
+
+  // Header: magic, version, six u64 fields, count, u32 entry, i32 top level;
+  // then 2 x 4 floats, node 0's level byte and its layer-0 list size, whose
+  // only neighbour is node 1.
+  constexpr std::streamoff top_level_offset = 8 + 4 + 6 * 8 + 8 + 4;
+  constexpr std::streamoff neighbour_offset =
+      top_level_offset + 4 + 2 * 4 * sizeof(float) + 1 + 4;
+  auto corrupt = [&](std::streamoff offset, auto value) {
+    index.save(path);
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(offset);
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+
+  corrupt(top_level_offset, std::int32_t{200});
+  EXPECT_THROW(Index::load(path), std::runtime_error);
+  corrupt(neighbour_offset, std::uint32_t{7});
+  EXPECT_THROW(Index::load(path), std::runtime_error);
+  corrupt(neighbour_offset, std::uint32_t{1});
+  EXPECT_EQ(Index::load(path).size(), 2u);
+  std::remove(path.c_str());
+}
+
+TEST(HNSWTest, ValidatesParametersAndEmptyIndex) {
+  HNSW<float, 4>::parameters params;
+  params.M = 1;
+  using Index = HNSW<float, 4>;
+  EXPECT_THROW(Index{params}, std::invalid_argument);
+
+  HNSW<float, 4> index;
+  EXPECT_TRUE(index.search(Point<float, 4>({0, 0, 0, 0}), 3).empty());
+  EXPECT_THROW(index.set_ef_search(0), std::invalid_argument);
+  index.add(Point<float, 4>({1, 2, 3, 4}));
+  auto result = index.search(Point<float, 4>({0, 0, 0, 0}), 3);
+  ASSERT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].index, 0u);
+}
@@ -0,0 +1,140 @@
+#include "../Core/KDTree.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+template <size_t Dim>
+std::vector<Point<double, Dim>> random_points(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(-10.0, 10.0);
+  std::vector<Point<double, Dim>> points;
+  for (size_t i = 0; i < count; ++i) {
+    std::array<double, Dim> coords;
+    for (auto &c : coords)
+      c = coord(rng);
+    points.emplace_back(coords);
+  }
+  return points;
+}
+} // namespace
+
+TEST(KDTreeTest, NearestMatchesBruteForce) {
+  auto points = random_points<3>(5000, 1);
+  KDTree<double, 3> tree(points, 4);
+  ASSERT_EQ(tree.size(), points.size());
+
+  for (const auto &query : random_points<3>(50, 2)) {
+    auto result = tree.nearest(query, 7);
+    ASSERT_EQ(result.size(), 7u);
+
+    std::vector<double> expected;
+    for (const auto &p : points)
+      expected.push_back(p.squared_distance(query));
+    std::sort(expected.begin(), expected.end());
+    for (size_t i = 0; i < result.size(); ++i) {
+      EXPECT_DOUBLE_EQ(result[i].squared_distance, expected[i]);
+      EXPECT_DOUBLE_EQ(points[result[i].index].squared_distance(query),
+                       expected[i]);
+    }
+  }
+}
+
+TEST(KDTreeTest, SplitsOnAxesPast255) {
+  // Points spread widely on axis 290 and narrowly on axis 34, which is
+  // where 290 lands if the split axis is truncated to a byte.
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> coord(-1.0, 1.0);
+  auto sample = [&] {
+    std::array<double, 300> coords{};
+    coords[34] = coord(rng);
+    coords[290] = 100 * coord(rng);
+    return Point<double, 300>(coords);
+  };
+  std::vector<Point<double, 300>> points;
+  for (int i = 0; i < 500; ++i)
+    points.push_back(sample());
+  KDTree<double, 300> tree(points);
+
+  for (int q = 0; q < 50; ++q) {
+    auto query = sample();
+    auto result = tree.nearest(query, 3);
+    std::vector<double> expected;
+    for (const auto &p : points)
+      expected.push_back(p.squared_distance(query));
+    std::sort(expected.begin(), expected.end());
+    for (size_t i = 0; i < result.size(); ++i)
+      EXPECT_DOUBLE_EQ(result[i].squared_distance, expected[i]);
+  }
+}
+
+TEST(KDTreeTest, RadiusAndBoxMatchBruteForce) {
+  auto points = random_points<2>(3000, 3);
+  PointCloud<double, 2> cloud(points);
+  KDTree<double, 2> tree(cloud);
+
+  for (const auto &query : random_points<2>(30, 4)) {
+    auto found = tree.within_radius(query, 1.5);
+    std::vector<size_t> indices;
+    for (const auto &n : found)
+      indices.push_back(n.index);
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < points.size(); ++i)
+      if (points[i].squared_distance(query) <= 1.5 * 1.5)
+        expected.push_back(i);
+    EXPECT_EQ(indices, expected);
+
+    Point<double, 2> lower({query[0] - 1.0, query[1] - 2.0});
+    Point<double, 2> upper({query[0] + 2.0, query[1] + 0.5});
+    auto boxed = tree.in_box(lower, upper);
+    std::sort(boxed.begin(), boxed.end());
+    std::vector<size_t> expected_box;
+    for (size_t i = 0; i < points.size(); ++i)
+      if (points[i][0] >= lower[0] && points[i][0] <= upper[0] &&
+          points[i][1] >= lower[1] && points[i][1] <= upper[1])
+        expected_box.push_back(i);
+    EXPECT_EQ(boxed, expected_box);
+  }
+}
+
+TEST(KDTreeTest, BatchedQueriesMatchSingleQueries) {
+  auto points = random_points<3>(2000, 5);
+  KDTree<double, 3> tree(points);
+  auto queries = random_points<3>(300, 6);
+
+  auto batched = tree.nearest(std::span<const Point<double, 3>>(queries), 3, 4);
+  auto radius =
+      tree.within_radius(std::span<const Point<double, 3>>(queries), 2.0, 4);
+  ASSERT_EQ(batched.size(), queries.size());
+  for (size_t q = 0; q < queries.size(); ++q) {
+    auto single = tree.nearest(queries[q], 3);
+    ASSERT_EQ(batched[q].size(), single.size());
+    for (size_t i = 0; i < single.size(); ++i)
+      EXPECT_EQ(batched[q][i].index, single[i].index);
+    EXPECT_EQ(radius[q].size(), tree.within_radius(queries[q], 2.0).size());
+  }
+}
+
+TEST(KDTreeTest, HandlesSmallDuplicateAndIntegerInputs) {
+  KDTree<double, 2> empty_tree;
+  EXPECT_TRUE(empty_tree.nearest(Point<double, 2>({0.0, 0.0}), 3).empty());
+
+  std::vector<Point<int, 2>> grid;
+  for (int x = 0; x < 20; ++x)
+    for (int y = 0; y < 20; ++y)
+      grid.push_back(Point<int, 2>({x % 10, y}));
+  KDTree<int, 2> tree(grid, 2);
+
+  auto nearest = tree.nearest(Point<int, 2>({3, 4}), 2);
+  ASSERT_EQ(nearest.size(), 2u);
+  EXPECT_EQ(nearest[0].squared_distance, 0.0);
+  EXPECT_EQ(nearest[1].squared_distance, 0.0); // every point appears twice
+  EXPECT_EQ(tree.nearest(Point<int, 2>({0, 0}), 1000).size(), grid.size());
+  EXPECT_EQ(tree.in_box(Point<int, 2>({2, 2}), Point<int, 2>({3, 3})).size(),
+            8u);
+}
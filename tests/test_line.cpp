@@ -0,0 +1,106 @@
+#include "../Core/Line.hpp"
+#include <gtest/gtest.h>
+
+using namespace GeomCPP;
+
+using Point2D = Point<double, 2>;
+using Line2D = Line<double, 2>;
+
+TEST(LineTest, ConstructorRejectsDegenerateLine) {
+  Point2D p({1.0, 1.0});
+  EXPECT_THROW(Line2D(p, p), std::invalid_argument);
+}
+
+TEST(LineTest, Length) {
+  Line2D line(Point2D({0.0, 0.0}), Point2D({3.0, 4.0}));
+  EXPECT_DOUBLE_EQ(line.length(), 5.0);
+}
+
+TEST(LineTest, Contains) {
+  Line2D line(Point2D({0.0, 0.0}), Point2D({4.0, 4.0}));
+  EXPECT_TRUE(line.contains(Point2D({2.0, 2.0})));
+  EXPECT_TRUE(line.contains(Point2D({4.0, 4.0})));
+  EXPECT_FALSE(line.contains(Point2D({5.0, 5.0})));
+  EXPECT_FALSE(line.contains(Point2D({2.0, 3.0})));
+}
+
+TEST(LineTest, ParallelAndIntersects) {
+  Line2D a(Point2D({0.0, 0.0}), Point2D({4.0, 4.0}));
+  Line2D b(Point2D({0.0, 1.0}), Point2D({4.0, 5.0}));
+  Line2D c(Point2D({0.0, 4.0}), Point2D({4.0, 0.0}));
+  Line2D d(Point2D({5.0, 0.0}), Point2D({6.0, -3.0}));
+
+  EXPECT_TRUE(a.is_parallel(b));
+  EXPECT_FALSE(a.intersects(b));
+  EXPECT_TRUE(a.intersects(c));
+  EXPECT_FALSE(a.intersects(d));
+}
+
+namespace {
+constexpr Line2D kDiagonal(Point2D({0.0, 0.0}), Point2D({3.0, 4.0}));
+constexpr Line2D kAntiDiagonal(Point2D({0.0, 4.0}), Point2D({3.0, 0.0}));
+
+consteval bool builds_at_compile_time() {
+  Line2D line(Point2D({0.0, 0.0}), Point2D({1.0, 0.0}));
+  return line.get_end()[0] == 1.0;
+}
+} // namespace
+
+static_assert(kDiagonal.length() == 5.0);
+static_assert(kDiagonal.get_start() == Point2D({0.0, 0.0}));
+static_assert(kDiagonal.contains(Point2D({1.5, 2.0})));
+static_assert(!kDiagonal.contains(Point2D({1.5, 2.5})));
+static_assert(!kDiagonal.is_parallel(kAntiDiagonal));
+static_assert(kDiagonal.intersects(kAntiDiagonal));
+static_assert(builds_at_compile_time());
+
+using IntPoint = Point<int, 2>;
+using IntLine = Line<int, 2>;
+using BigPoint = Point<long long, 2>;
+using BigLine = Line<long long, 2>;
+
+TEST(IntegerLineTest, ExactContainment) {
+  IntLine line(IntPoint({0, 0}), IntPoint({6, 4}));
+  EXPECT_TRUE(line.contains(IntPoint({3, 2})));
+  EXPECT_TRUE(line.contains(IntPoint({6, 4})));
+  EXPECT_FALSE(line.contains(IntPoint({2, 1})));
+  EXPECT_FALSE(line.contains(IntPoint({9, 6})));
+
+  // Integer division in a ratio test would call (1, 0) a point of this line.
+  IntLine shallow(IntPoint({0, 0}), IntPoint({3, 1}));
+  EXPECT_FALSE(shallow.contains(IntPoint({1, 0})));
+}
+
+TEST(IntegerLineTest, ExactParallelAndIntersection) {
+  IntLine a(IntPoint({0, 0}), IntPoint({4, 4}));
+  IntLine b(IntPoint({0, 1}), IntPoint({4, 5}));
+  IntLine c(IntPoint({0, 4}), IntPoint({4, 0}));
+  IntLine touching(IntPoint({4, 4}), IntPoint({8, 0}));
+  IntLine apart(IntPoint({5, 0}), IntPoint({6, -3}));
+
+  EXPECT_TRUE(a.is_parallel(b));
+  EXPECT_FALSE(a.intersects(b));
+  EXPECT_TRUE(a.intersects(c));
+  EXPECT_TRUE(a.intersects(touching));
+  EXPECT_FALSE(a.intersects(apart));
+}
+
+TEST(IntegerLineTest, SixtyFourBitCoordinatesDoNotOverflow) {
+  constexpr long long big = 4'000'000'000'000'000'000LL;
+  BigLine diagonal(BigPoint({-big, -big}), BigPoint({big, big}));
+  BigLine nearly(BigPoint({-big, -big}), BigPoint({big, big - 1}));
+
+  EXPECT_TRUE(diagonal.contains(BigPoint({0, 0})));
+  EXPECT_FALSE(diagonal.contains(BigPoint({1, 0})));
+  EXPECT_FALSE(diagonal.is_parallel(nearly));
+  EXPECT_TRUE(BigPoint::collinear(BigPoint({-big, -big}), BigPoint({0, 0}),
+                                  BigPoint({big, big})));
+  EXPECT_FALSE(BigPoint::collinear(BigPoint({-big, -big}), BigPoint({0, 1}),
+                                   BigPoint({big, big})));
+}
+
+static_assert(IntPoint({1, 2}) == IntPoint({1, 2}));
+static_assert(!(IntPoint({1, 2}) == IntPoint({1, 3})));
+static_assert(exact_orientation(0, 0, 1, 0, 0, 1) == 1);
+static_assert(exact_orientation(0, 0, 1, 0, 0, -1) == -1);
+static_assert(exact_orientation(0, 0, 2, 2, 5, 5) == 0);
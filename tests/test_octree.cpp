@@ -0,0 +1,110 @@
+#include "../Core/Octree.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+using P = Point<double, 3>;
+using Box = BoundingBox<double, 3>;
+
+std::vector<P> random_points(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(-20.0, 20.0);
+  std::normal_distribution<double> cluster(5.0, 0.5);
+  std::vector<P> points;
+  for (size_t i = 0; i < count; ++i) {
+    // Half uniform, half in a tight cluster to force deep nodes.
+    if (i % 2 == 0)
+      points.push_back(P({coord(rng), coord(rng), coord(rng)}));
+    else
+      points.push_back(P({cluster(rng), cluster(rng), cluster(rng)}));
+  }
+  return points;
+}
+
+std::vector<size_t> sorted(std::vector<size_t> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+} // namespace
+
+TEST(OctreeTest, QueriesMatchBruteForce) {
+  auto points = random_points(6000, 1);
+  Octree<double> tree(points, 16, 4);
+  EXPECT_EQ(tree.size(), points.size());
+  EXPECT_GT(tree.node_count(), 1u);
+
+  for (const P &query : random_points(20, 2)) {
+    std::vector<double> distances;
+    for (const P &p : points)
+      distances.push_back(p.squared_distance(query));
+
+    auto nearest = tree.nearest(query, 5);
+    auto expected = distances;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(nearest.size(), 5u);
+    for (size_t i = 0; i < nearest.size(); ++i)
+      EXPECT_DOUBLE_EQ(nearest[i].squared_distance, expected[i]);
+
+    std::vector<size_t> radius_ids;
+    for (const auto &n : tree.within_radius(query, 2.5))
+      radius_ids.push_back(n.index);
+    std::vector<size_t> expected_radius;
+    for (size_t i = 0; i < points.size(); ++i)
+      if (distances[i] <= 2.5 * 2.5)
+        expected_radius.push_back(i);
+    EXPECT_EQ(sorted(radius_ids), expected_radius);
+
+    Box area = Box::of(query, P({query[0] + 6.0, query[1] + 3.0,
+                                 query[2] + 9.0}));
+    std::vector<size_t> expected_box;
+    for (size_t i = 0; i < points.size(); ++i)
+      if (area.contains(points[i]))
+        expected_box.push_back(i);
+    EXPECT_EQ(sorted(tree.in_box(area)), expected_box);
+  }
+}
+
+TEST(OctreeTest, RepresentativesStayInBoxAndRespectBudget) {
+  auto points = random_points(20000, 3);
+  PointCloud<double, 3> cloud(points);
+  Octree<double> tree(cloud);
+
+  Box area = Box::of(P({-10.0, -10.0, -10.0}), P({10.0, 10.0, 10.0}));
+  size_t inside = tree.in_box(area).size();
+  ASSERT_GT(inside, 100u);
+
+  for (size_t budget : {size_t{1}, size_t{10}, size_t{100}, size_t{1000}}) {
+    auto preview = tree.representatives(area, budget);
+    EXPECT_LE(preview.size(), budget);
+    EXPECT_FALSE(preview.empty());
+    std::set<size_t> unique(preview.begin(), preview.end());
+    EXPECT_EQ(unique.size(), preview.size());
+    for (size_t id : preview)
+      EXPECT_TRUE(area.contains(points[id]));
+  }
+
+  // A budget larger than the box's population returns every point in it.
+  EXPECT_EQ(sorted(tree.representatives(area, inside + 1)),
+            sorted(tree.in_box(area)));
+  EXPECT_TRUE(
+      tree.representatives(Box::of(P({30.0, 30.0, 30.0}),
+                                   P({40.0, 40.0, 40.0})),
+                           10)
+          .empty());
+}
+
+TEST(OctreeTest, HandlesDuplicatesAndEdgeCases) {
+  std::vector<P> same(100, P({1.0, 2.0, 3.0}));
+  Octree<double> tree(same, 4);
+  EXPECT_EQ(tree.nearest(P({0.0, 0.0, 0.0}), 150).size(), 100u);
+  EXPECT_EQ(tree.within_radius(P({1.0, 2.0, 3.0}), 0.0).size(), 100u);
+
+  Octree<double> empty_tree;
+  EXPECT_TRUE(empty_tree.nearest(P({0.0, 0.0, 0.0}), 1).empty());
+  EXPECT_THROW(Octree<double>(same, 0), std::invalid_argument);
+}
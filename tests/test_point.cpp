@@ -1,5 +1,9 @@
 #include "../Core/Point.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 using namespace GeomCPP;
 
@@ -99,6 +103,14 @@ TEST(PointTest, Collinearity) {
   EXPECT_FALSE(Point2D::collinear(p1, p2, p4));
 }
 
+TEST(PointTest, CollinearityMixedTypes) {
+  using Point2I = Point<int, 2>;
+  EXPECT_TRUE(Point2I::collinear(Point2I({0, 0}), Point2D({0.5, 1.0}),
+                                 Point2I({2, 4})));
+  EXPECT_FALSE(Point2I::collinear(Point2I({0, 0}), Point2D({0.5, 1.1}),
+                                  Point2I({2, 4})));
+}
+
 TEST(PointTest, GetDimensions) {
   std::array<double, 2> coords = {1.0, 2.0};
   Point2D p(coords);
@@ -204,3 +216,158 @@ TEST(TestReflection, TestReflection3D) {
   EXPECT_DOUBLE_EQ(result[1], Expected[1]);
   EXPECT_DOUBLE_EQ(result[2], Expected[2]);
 }
+
+namespace {
+constexpr Point2D kUnitX({1.0, 0.0});
+constexpr Point2D kUnitY({0.0, 1.0});
+constexpr std::array<Point2D, 4> kStencil = {
+    kUnitX, kUnitY, Point2D({-1.0, 0.0}), Point2D({0.0, -1.0})};
+
+consteval Point2D stencil_sum() {
+  Point2D sum({0.0, 0.0});
+  for (const auto &p : kStencil)
+    sum = sum + p;
+  return sum;
+}
+} // namespace
+
+static_assert((kUnitX + kUnitY).get_coordinates() ==
+              std::array<double, 2>{1.0, 1.0});
+static_assert((kUnitX - kUnitY)[1] == -1.0);
+static_assert(kUnitX.dot(kUnitY) == 0.0);
+static_assert(kUnitX == Point2D({1.0, 0.0}));
+static_assert(!(kUnitX == kUnitY));
+static_assert(Point2D({3.0, 4.0}).magnitude() == 5.0);
+static_assert(Point3D({2.0, 3.0, 6.0}).distance(Point3D({0.0, 0.0, 0.0})) ==
+              7.0);
+static_assert((Point2D({6.0, 9.0}) / 3.0)[1] == 3.0);
+static_assert(stencil_sum() == Point2D({0.0, 0.0}));
+static_assert(Point2D({2.0, 3.0}).reflect(Point2D({0.0, 0.0}),
+                                          Point2D({1.0, 1.0})) ==
+              Point2D({3.0, 2.0}));
+static_assert(Point3D({3.0, 4.0, 5.0})
+                  .reflect(Point3D({0.0, 0.0, 0.0}),
+                           Point3D({0.0, 0.0, 1.0}))[2] == -5.0);
+static_assert(Point2D::collinear(Point2D({0.0, 0.0}), Point2D({1.0, 1.0}),
+                                 Point2D({2.0, 2.0})));
+
+TEST(PointConstexprTest, SqrtMatchesRuntime) {
+  constexpr double root_two = constexpr_sqrt(2.0);
+  EXPECT_EQ(root_two, std::sqrt(2.0));
+  constexpr double big = constexpr_sqrt(1e300);
+  EXPECT_DOUBLE_EQ(big, std::sqrt(1e300));
+  constexpr double tiny = constexpr_sqrt(1e-300);
+  EXPECT_DOUBLE_EQ(tiny, std::sqrt(1e-300));
+  EXPECT_TRUE(std::isnan(constexpr_sqrt(-1.0)));
+}
+
+TEST(PointExpressionTest, ChainedArithmeticEvaluatesOnAssignment) {
+  Point3D p1({1.0, 2.0, 3.0});
+  Point3D p2({4.0, 5.0, 6.0});
+  Point3D p3({0.5, 0.5, 0.5});
+
+  Point3D result = p1 + p2 - p3;
+  EXPECT_EQ(result.get_coordinates(), (std::array<double, 3>{4.5, 6.5, 8.5}));
+
+  result = (p1 + p2) * 2.0 / 4.0;
+  EXPECT_EQ(result.get_coordinates(), (std::array<double, 3>{2.5, 3.5, 4.5}));
+
+  result = 3.0 * p1;
+  EXPECT_EQ(result.get_coordinates(), (std::array<double, 3>{3.0, 6.0, 9.0}));
+}
+
+TEST(PointExpressionTest, AssignmentMayAliasOperands) {
+  Point2D p({1.0, 2.0});
+  Point2D q({10.0, 20.0});
+  p = q - p + p * 2.0;
+  EXPECT_EQ(p.get_coordinates(), (std::array<double, 2>{11.0, 22.0}));
+}
+
+TEST(PointExpressionTest, AutoKeepsTemporaryOperandsAlive) {
+  auto make = [](double x, double y) { return Point2D({x, y}); };
+
+  // Temporary operands are stored by value, so the expression stays valid
+  // after the full expression that built it.
+  auto d = make(4.0, 6.0) - make(1.0, 2.0);
+  auto scaled = (make(1.0, 1.0) + make(2.0, 3.0)) * 2.0;
+  Point2D named({1.0, 1.0});
+  auto mixed = named + make(0.5, 0.5);
+  EXPECT_DOUBLE_EQ(d.magnitude(), 5.0);
+  EXPECT_EQ(scaled.get_coordinates(), (std::array<double, 2>{6.0, 8.0}));
+  EXPECT_EQ(mixed.get_coordinates(), (std::array<double, 2>{1.5, 1.5}));
+
+  static_assert(sizeof(d) >= 2 * sizeof(Point2D));
+}
+
+namespace {
+// Point-like leaf that records every coordinate read as (id, index).
+struct logged_operand {
+  using value_type = double;
+  static constexpr size_t get_dimensions() { return 2; }
+
+  int id;
+  std::vector<std::pair<int, size_t>> *reads;
+
+  double coordinate(size_t index) const {
+    reads->emplace_back(id, index);
+    return id + 0.5 * index;
+  }
+};
+} // namespace
+
+TEST(PointExpressionTest, ChainEvaluatesInOnePass) {
+  std::vector<std::pair<int, size_t>> reads;
+  logged_operand a{1, &reads}, b{2, &reads}, c{3, &reads};
+
+  // Every operand is read at index 0 before any is read at index 1; an
+  // intermediate Point for a + b would read a and b in full before c.
+  Point2D result = a + b - c;
+  EXPECT_EQ(result.get_coordinates(), (std::array<double, 2>{0.0, 0.5}));
+  ASSERT_EQ(reads.size(), 6u);
+  for (size_t i = 0; i < reads.size(); ++i)
+    EXPECT_EQ(reads[i].second, i / 3) << "read " << i;
+  std::sort(reads.begin(), reads.end());
+  std::vector<std::pair<int, size_t>> expected = {{1, 0}, {1, 1}, {2, 0},
+                                                  {2, 1}, {3, 0}, {3, 1}};
+  EXPECT_EQ(reads, expected);
+
+  // Named Points are referenced, not copied, by the nodes of a chain.
+  using Point8 = Point<double, 8>;
+  Point8 p({}), q({}), r({});
+  static_assert(sizeof(p + q - r) < sizeof(Point8));
+}
+
+TEST(PointExpressionTest, AutoReferencesNamedPoints) {
+  Point2D p1({1.0, 2.0});
+  Point2D p2({3.0, 2.0});
+
+  // Like Eigen, `auto` keeps the expression, which reads its named operands
+  // when evaluated; eval() or a Point target captures the value instead.
+  auto s = p1 + p2;
+  Point2D kept = p1 + p2;
+  auto snapshot = (p1 + p2).eval();
+  p1.scale(10.0);
+  EXPECT_EQ(s.get_coordinates(), (std::array<double, 2>{13.0, 22.0}));
+  EXPECT_EQ(kept.get_coordinates(), (std::array<double, 2>{4.0, 4.0}));
+  EXPECT_EQ(snapshot.get_coordinates(), (std::array<double, 2>{4.0, 4.0}));
+  static_assert(std::is_same_v<decltype(snapshot), Point2D>);
+
+  Point2D c({0.5, 0.5});
+  auto chain = p1 + p2 - c;
+  c.scale(4.0);
+  EXPECT_EQ(chain.get_coordinates(), (std::array<double, 2>{11.0, 20.0}));
+}
+
+TEST(PointExpressionTest, ExpressionsExposePointInterface) {
+  Point2D p1({1.0, 2.0});
+  Point2D p2({2.0, 2.0});
+
+  EXPECT_EQ((p1 + p2)[1], 4.0);
+  EXPECT_THROW((p1 + p2)[2], std::out_of_range);
+  EXPECT_DOUBLE_EQ((p2 - p1).magnitude(), 1.0);
+  EXPECT_DOUBLE_EQ((p1 + p1).dot(p2), 12.0);
+  EXPECT_TRUE(p1 + p2 == Point2D({3.0, 4.0}));
+  EXPECT_THROW((p1 + p2) / 0.0, std::runtime_error);
+}
+
+static_assert((kUnitX * 2.0 + kUnitY / 2.0).eval() == Point2D({2.0, 0.5}));
@@ -0,0 +1,74 @@
+#include "../Core/PointCloud.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+
+using namespace GeomCPP;
+
+using Point2D = Point<double, 2>;
+using Cloud2D = PointCloud<double, 2>;
+
+TEST(PointCloudTest, RoundTripPoints) {
+  std::vector<Point2D> points = {Point2D({1.0, 2.0}), Point2D({3.0, 4.0}),
+                                 Point2D({-5.0, 6.0})};
+  Cloud2D cloud(points);
+
+  EXPECT_EQ(cloud.size(), 3);
+  EXPECT_EQ(cloud.get_dimensions(), 2);
+  EXPECT_EQ(cloud.axis_data(0)[2], -5.0);
+  EXPECT_EQ(cloud.axis_data(1)[1], 4.0);
+
+  auto back = cloud.to_points();
+  for (size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(back[i].get_coordinates(), points[i].get_coordinates());
+
+  EXPECT_THROW(cloud[3], std::out_of_range);
+}
+
+TEST(PointCloudTest, AxesAreAligned) {
+  PointCloud<float, 3> cloud(17);
+  for (size_t d = 0; d < 3; ++d)
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(cloud.axis_data(d)) % 64, 0u);
+}
+
+TEST(PointCloudTest, AdditionAndSubtraction) {
+  Cloud2D a({Point2D({1.0, 2.0}), Point2D({3.0, 4.0})});
+  Cloud2D b({Point2D({5.0, 6.0}), Point2D({7.0, 8.0})});
+
+  auto sum = a + b;
+  auto diff = b - a;
+  EXPECT_EQ(sum[1].get_coordinates(), (std::array<double, 2>{10.0, 12.0}));
+  EXPECT_EQ(diff[0].get_coordinates(), (std::array<double, 2>{4.0, 4.0}));
+
+  auto shifted = a + Point2D({1.0, -1.0});
+  EXPECT_EQ(shifted[1].get_coordinates(), (std::array<double, 2>{4.0, 3.0}));
+
+  EXPECT_THROW(a + Cloud2D(3), std::invalid_argument);
+}
+
+TEST(PointCloudTest, MatchesPointKernels) {
+  std::vector<Point2D> lhs, rhs;
+  for (int i = 0; i < 100; ++i) {
+    lhs.push_back(Point2D({i * 0.5, -i * 1.5}));
+    rhs.push_back(Point2D({i * 2.0 + 1.0, i * 0.25}));
+  }
+  Cloud2D a(lhs), b(rhs);
+
+  auto dots = a.dot(b);
+  auto dists = a.distance(b);
+  auto origin_dists = a.distance(Point2D({0.0, 0.0}));
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    EXPECT_DOUBLE_EQ(dots[i], lhs[i].dot(rhs[i]));
+    EXPECT_DOUBLE_EQ(dists[i], lhs[i].distance(rhs[i]));
+    EXPECT_DOUBLE_EQ(origin_dists[i], lhs[i].magnitude());
+  }
+}
+
+TEST(PointCloudTest, ScaleAndDivision) {
+  Cloud2D cloud({Point2D({2.0, 3.0}), Point2D({-4.0, 8.0})});
+  cloud.scale(2.0);
+  EXPECT_EQ(cloud[1].get_coordinates(), (std::array<double, 2>{-8.0, 16.0}));
+
+  auto halved = cloud / 4.0;
+  EXPECT_EQ(halved[0].get_coordinates(), (std::array<double, 2>{1.0, 1.5}));
+  EXPECT_THROW(cloud / 0.0, std::runtime_error);
+}
@@ -0,0 +1,96 @@
+#include "../Core/PQIndex.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+template <size_t Dim>
+std::vector<Point<float, Dim>> clustered_points(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> centre(0.0f, 4.0f), noise(0.0f, 0.5f);
+  std::vector<std::array<float, Dim>> centres(32);
+  for (auto &c : centres)
+    for (auto &x : c)
+      x = centre(rng);
+  std::uniform_int_distribution<size_t> pick(0, centres.size() - 1);
+  std::vector<Point<float, Dim>> points;
+  for (size_t i = 0; i < count; ++i) {
+    std::array<float, Dim> coords = centres[pick(rng)];
+    for (auto &x : coords)
+      x += noise(rng);
+    points.emplace_back(coords);
+  }
+  return points;
+}
+
+// Fraction of the true 10 nearest neighbours found in the returned lists.
+template <size_t Dim, typename Result>
+double recall_at_10(const std::vector<Point<float, Dim>> &points,
+                    const std::vector<Point<float, Dim>> &queries,
+                    const std::vector<Result> &results) {
+  size_t hits = 0;
+  for (size_t q = 0; q < queries.size(); ++q) {
+    std::vector<std::pair<float, size_t>> exact;
+    for (size_t i = 0; i < points.size(); ++i)
+      exact.emplace_back(queries[q].squared_distance(points[i]), i);
+    std::partial_sort(exact.begin(), exact.begin() + 10, exact.end());
+    for (size_t i = 0; i < 10; ++i)
+      for (const auto &n : results[q])
+        hits += n.index == exact[i].second;
+  }
+  return static_cast<double>(hits) / (10.0 * queries.size());
+}
+} // namespace
+
+TEST(PQIndexTest, FlatSearchFindsNearNeighbours) {
+  auto points = clustered_points<32>(3000, 1);
+  auto queries = clustered_points<32>(50, 2);
+  ProductQuantizer<float, 32> pq(8);
+  pq.train(std::span<const Point<float, 32>>(points).first(1000), 8);
+  PQIndex<float, 32> index(pq);
+  index.add(points, 4);
+  ASSERT_EQ(index.size(), points.size());
+
+  auto results = index.search(queries, 50, 4);
+  for (const auto &result : results) {
+    ASSERT_EQ(result.size(), 50u);
+    EXPECT_TRUE(std::is_sorted(
+        result.begin(), result.end(), [](const auto &a, const auto &b) {
+          return a.squared_distance < b.squared_distance;
+        }));
+  }
+  // The true 10 nearest are nearly always within the 50 best codes.
+  EXPECT_GT(recall_at_10(points, queries, results), 0.8);
+
+  using Flat = PQIndex<float, 32>;
+  EXPECT_THROW(Flat(ProductQuantizer<float, 32>(8)), std::invalid_argument);
+}
+
+TEST(PQIndexTest, InvertedFileMatchesFlatWhenProbingEveryList) {
+  auto points = clustered_points<32>(3000, 3);
+  auto queries = clustered_points<32>(50, 4);
+  IVFPQIndex<float, 32> index(16, 8);
+  EXPECT_THROW(index.add(points), std::runtime_error);
+  index.train(std::span<const Point<float, 32>>(points).first(1000), 8, 42,
+              4);
+  index.add(std::span<const Point<float, 32>>(points).first(1000), 4);
+  index.add(std::span<const Point<float, 32>>(points).subspan(1000), 4);
+  ASSERT_EQ(index.size(), points.size());
+
+  auto all = index.search(queries, 50, 16, 4);
+  EXPECT_GT(recall_at_10(points, queries, all), 0.9);
+
+  // Probing a few lists loses little on clustered data.
+  auto few = index.search(queries, 50, 4, 4);
+  EXPECT_GT(recall_at_10(points, queries, few), 0.8);
+  for (size_t q = 0; q < queries.size(); ++q)
+    EXPECT_LE(all[q].front().squared_distance,
+              few[q].front().squared_distance);
+
+  using Inverted = IVFPQIndex<float, 32>;
+  EXPECT_THROW(Inverted(0, 8), std::invalid_argument);
+}
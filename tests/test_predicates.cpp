@@ -0,0 +1,126 @@
+#include "../Core/Line.hpp"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace GeomCPP;
+
+namespace {
+int sign(double value) { return (value > 0) - (value < 0); }
+
+int sign(int128_t value) { return (value > 0) - (value < 0); }
+
+// Near-degenerate integer-valued inputs whose exact determinants fit in 128
+// bits, so the expansion fallback can be checked against integer arithmetic.
+std::int64_t near(std::mt19937_64 &rng, std::int64_t base, int spread) {
+  return base + static_cast<std::int64_t>(rng() % (2 * spread + 1)) - spread;
+}
+} // namespace
+
+TEST(PredicatesTest, Orient2dOnClassicNearCollinearGrid) {
+  // Shewchuk's example: naive evaluation of these points gives the wrong sign
+  // for many one-ulp perturbations of a.
+  double b[2] = {12.0, 12.0}, c[2] = {24.0, 24.0};
+  for (int i = 0; i < 64; ++i) {
+    for (int j = 0; j < 64; ++j) {
+      double ax = 0.5 + i * 0x1p-53;
+      double ay = 0.5 + j * 0x1p-53;
+      // With b and c on y = x, the orientation is the sign of ay - ax.
+      EXPECT_EQ(sign(orient2d(ax, ay, b[0], b[1], c[0], c[1])),
+                sign(ay - ax));
+    }
+  }
+}
+
+TEST(PredicatesTest, Orient2dMatchesExactIntegers) {
+  std::mt19937_64 rng(7);
+  const std::int64_t base = std::int64_t{1} << 50;
+  for (int trial = 0; trial < 2000; ++trial) {
+    std::int64_t ax = near(rng, base, 3), ay = near(rng, base, 3);
+    std::int64_t bx = near(rng, 2 * base, 3), by = near(rng, 2 * base, 3);
+    std::int64_t cx = near(rng, 3 * base, 3), cy = near(rng, 3 * base, 3);
+    int128_t exact =
+        int128_t(bx - ax) * (cy - ay) - int128_t(by - ay) * (cx - ax);
+    EXPECT_EQ(sign(orient2d(double(ax), double(ay), double(bx), double(by),
+                            double(cx), double(cy))),
+              sign(exact));
+  }
+}
+
+TEST(PredicatesTest, Orient3dMatchesExactIntegers) {
+  std::mt19937_64 rng(11);
+  const std::int64_t base = std::int64_t{1} << 29;
+  for (int trial = 0; trial < 2000; ++trial) {
+    std::int64_t p[4][3];
+    for (int k = 0; k < 4; ++k)
+      for (int d = 0; d < 3; ++d)
+        p[k][d] = near(rng, (k + 1) * base, 2);
+    int128_t m[3][3];
+    for (int k = 0; k < 3; ++k)
+      for (int d = 0; d < 3; ++d)
+        m[k][d] = p[k][d] - p[3][d];
+    int128_t exact = m[0][2] * (m[1][0] * m[2][1] - m[2][0] * m[1][1]) +
+                     m[1][2] * (m[2][0] * m[0][1] - m[0][0] * m[2][1]) +
+                     m[2][2] * (m[0][0] * m[1][1] - m[1][0] * m[0][1]);
+    double result = orient3d(p[0][0], p[0][1], p[0][2], p[1][0], p[1][1],
+                             p[1][2], p[2][0], p[2][1], p[2][2], p[3][0],
+                             p[3][1], p[3][2]);
+    EXPECT_EQ(sign(result), sign(exact));
+  }
+}
+
+TEST(PredicatesTest, IncircleMatchesExactIntegers) {
+  std::mt19937_64 rng(13);
+  const std::int64_t radius = std::int64_t{1} << 24;
+  for (int trial = 0; trial < 2000; ++trial) {
+    // Four points close to the circle of the given radius about the origin.
+    std::int64_t p[4][2] = {{near(rng, radius, 1), near(rng, 0, 1)},
+                            {near(rng, 0, 1), near(rng, radius, 1)},
+                            {near(rng, -radius, 1), near(rng, 0, 1)},
+                            {near(rng, 0, 1), near(rng, -radius, 1)}};
+    int128_t dx[3], dy[3], lift[3];
+    for (int k = 0; k < 3; ++k) {
+      dx[k] = p[k][0] - p[3][0];
+      dy[k] = p[k][1] - p[3][1];
+      lift[k] = dx[k] * dx[k] + dy[k] * dy[k];
+    }
+    int128_t exact = lift[0] * (dx[1] * dy[2] - dx[2] * dy[1]) +
+                     lift[1] * (dx[2] * dy[0] - dx[0] * dy[2]) +
+                     lift[2] * (dx[0] * dy[1] - dx[1] * dy[0]);
+    double result = incircle(p[0][0], p[0][1], p[1][0], p[1][1], p[2][0],
+                             p[2][1], p[3][0], p[3][1]);
+    EXPECT_EQ(sign(result), sign(exact));
+  }
+}
+
+TEST(PredicatesTest, LargeMagnitudeCollinearity) {
+  using Point2D = Point<double, 2>;
+  // A fixed 1e-9 epsilon rejects these exactly collinear points.
+  Point2D a({1e12, 1e12}), b({3e12, 2e12}), c({5e12, 3e12});
+  EXPECT_TRUE(Point2D::collinear(a, b, c));
+  // ...and accepts these clearly non-collinear ones at tiny magnitudes.
+  Point2D d({0.0, 0.0}), e({1e-6, 0.0}), f({0.0, 1e-6});
+  EXPECT_FALSE(Point2D::collinear(d, e, f));
+}
+
+TEST(PredicatesTest, LinePredicatesAreExact) {
+  using Point2D = Point<double, 2>;
+  using Line2D = Line<double, 2>;
+  Line2D a(Point2D({0.0, 0.0}), Point2D({1e-6, 1e-6}));
+  Line2D b(Point2D({0.0, 1e-7}), Point2D({1e-6, 1.1e-6}));
+  EXPECT_FALSE(a.is_parallel(b));
+
+  Line2D big(Point2D({0.0, 0.0}), Point2D({3e12, 1e12}));
+  Line2D shifted(Point2D({0.0, 1.0}), Point2D({3e12, 1e12 + 1.0}));
+  EXPECT_TRUE(big.is_parallel(shifted));
+
+  // The endpoint of the second segment lies exactly on the first.
+  Line2D touching(Point2D({1.5e12, 0.5e12}), Point2D({2e12, -1e12}));
+  EXPECT_TRUE(big.intersects(touching));
+  Line2D miss(Point2D({1.5e12, 0.5e12 + 1.0 / 1024}),
+              Point2D({2e12, 1e12}));
+  EXPECT_FALSE(big.intersects(miss));
+}
+
+static_assert(orient2d(0.0, 0.0, 1.0, 0.0, 0.0, 1.0) > 0);
+static_assert(orient2d(0.5 + 0x1p-53, 0.5, 12.0, 12.0, 24.0, 24.0) < 0);
+static_assert(incircle(1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, 0.0) > 0);
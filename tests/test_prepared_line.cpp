@@ -0,0 +1,88 @@
+#include "../Core/PreparedLine.hpp"
+#include <gtest/gtest.h>
+
+using namespace GeomCPP;
+
+using Point2D = Point<double, 2>;
+using Line2D = Line<double, 2>;
+using Prepared2D = PreparedLine<double, 2>;
+
+TEST(PreparedLineTest, CachesDirectionLengthAndBounds) {
+  Prepared2D line(Point2D({4.0, 1.0}), Point2D({1.0, 5.0}));
+  EXPECT_DOUBLE_EQ(line.get_direction()[0], -3.0);
+  EXPECT_DOUBLE_EQ(line.get_direction()[1], 4.0);
+  EXPECT_DOUBLE_EQ(line.get_squared_length(), 25.0);
+  EXPECT_DOUBLE_EQ(line.length(), 5.0);
+  EXPECT_DOUBLE_EQ(line.get_inverse_length(), 0.2);
+  EXPECT_DOUBLE_EQ(line.get_bounds().lower[0], 1.0);
+  EXPECT_DOUBLE_EQ(line.get_bounds().upper[1], 5.0);
+  EXPECT_DOUBLE_EQ(line.parameter(Point2D({2.5, 3.0})), 0.5);
+
+  Point2D p({1.0, 1.0});
+  EXPECT_THROW(Prepared2D(p, p), std::invalid_argument);
+}
+
+TEST(PreparedLineTest, Contains) {
+  Prepared2D line(Point2D({0.0, 0.0}), Point2D({4.0, 4.0}));
+  EXPECT_TRUE(line.contains(Point2D({2.0, 2.0})));
+  EXPECT_TRUE(line.contains(Point2D({4.0, 4.0})));
+  EXPECT_TRUE(line.contains(Point2D({0.1, 0.1})));
+  EXPECT_FALSE(line.contains(Point2D({5.0, 5.0})));
+  EXPECT_FALSE(line.contains(Point2D({2.0, 3.0})));
+  EXPECT_FALSE(line.contains(Point2D({2.0, 2.0 + 1e-6})));
+
+  // Axis-parallel: the fixed coordinate must match too.
+  Prepared2D flat(Point2D({0.0, 1.0}), Point2D({3.0, 1.0}));
+  EXPECT_TRUE(flat.contains(Point2D({1.5, 1.0})));
+  EXPECT_FALSE(flat.contains(Point2D({1.5, 1.5})));
+
+  Point<float, 3> a({0.0f, 0.0f, 0.0f}), b({0.3f, 0.6f, 0.9f});
+  PreparedLine<float, 3> skew(a, b);
+  EXPECT_TRUE(skew.contains(Point<float, 3>({0.1f, 0.2f, 0.3f})));
+  EXPECT_FALSE(skew.contains(Point<float, 3>({0.1f, 0.2f, 0.31f})));
+}
+
+TEST(PreparedLineTest, IntegerContainsMatchesLine) {
+  using Point3I = Point<int, 3>;
+  Line<int, 3> line(Point3I({-2, 1, 4}), Point3I({4, 4, -5}));
+  PreparedLine<int, 3> prepared(line);
+  for (int x = -3; x <= 5; ++x)
+    for (int y = 0; y <= 5; ++y)
+      for (int z = -6; z <= 5; ++z) {
+        Point3I p({x, y, z});
+        EXPECT_EQ(prepared.contains(p), line.contains(p));
+      }
+}
+
+TEST(PreparedLineTest, ParallelAndIntersectsMatchLine) {
+  // Every pair of segments between points of a small lattice, which covers
+  // touching, collinear, overlapping and parallel configurations.
+  std::vector<Point2D> lattice;
+  for (int x = 0; x < 4; ++x)
+    for (int y = 0; y < 3; ++y)
+      lattice.push_back(Point2D({x * 0.5, y * 0.75}));
+  std::vector<Line2D> lines;
+  for (size_t i = 0; i < lattice.size(); ++i)
+    for (size_t j = i + 1; j < lattice.size(); ++j)
+      lines.emplace_back(lattice[i], lattice[j]);
+
+  std::vector<Prepared2D> prepared;
+  for (const Line2D &line : lines)
+    prepared.emplace_back(line);
+  for (size_t i = 0; i < lines.size(); ++i)
+    for (size_t j = 0; j < lines.size(); ++j) {
+      ASSERT_EQ(prepared[i].is_parallel(prepared[j]),
+                lines[i].is_parallel(lines[j]));
+      ASSERT_EQ(prepared[i].intersects(prepared[j]),
+                lines[i].intersects(lines[j]));
+    }
+}
+
+TEST(PreparedLineTest, ParallelInHigherDimensions) {
+  using Point3D = Point<double, 3>;
+  PreparedLine<double, 3> a(Point3D({0.0, 0.0, 0.0}), Point3D({1.0, 2.0, 3.0}));
+  PreparedLine<double, 3> b(Point3D({1.0, 0.0, 0.0}), Point3D({3.0, 4.0, 6.0}));
+  PreparedLine<double, 3> c(Point3D({1.0, 0.0, 0.0}), Point3D({3.0, 4.0, 7.0}));
+  EXPECT_TRUE(a.is_parallel(b));
+  EXPECT_FALSE(a.is_parallel(c));
+}
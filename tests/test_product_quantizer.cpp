@@ -0,0 +1,86 @@
+#include "../Core/ProductQuantizer.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+// Points scattered around a few well separated cluster centres.
+template <size_t Dim>
+std::vector<Point<float, Dim>> clustered_points(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> noise(0.0f, 0.1f);
+  std::uniform_int_distribution<int> centre(0, 7);
+  std::vector<Point<float, Dim>> points;
+  for (size_t i = 0; i < count; ++i) {
+    int c = centre(rng);
+    std::array<float, Dim> coords;
+    for (size_t d = 0; d < Dim; ++d)
+      coords[d] = static_cast<float>((c >> (d % 3)) & 1) * 4 + noise(rng);
+    points.emplace_back(coords);
+  }
+  return points;
+}
+} // namespace
+
+TEST(ProductQuantizerTest, DecodedPointsStayClose) {
+  auto points = clustered_points<16>(1000, 1);
+  ProductQuantizer<float, 16> pq(4);
+  EXPECT_FALSE(pq.trained());
+  pq.train(points, 10, 7, 2);
+  ASSERT_TRUE(pq.trained());
+  EXPECT_EQ(pq.code_size(), 4u);
+
+  auto codes = pq.encode(std::span<const Point<float, 16>>(points), 2);
+  ASSERT_EQ(codes.size(), points.size() * 4);
+  double error = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    auto decoded = pq.decode(
+        std::span<const std::uint8_t>(codes.data() + i * 4, 4));
+    error += decoded.squared_distance(points[i]);
+  }
+  // The noise alone has a squared norm of about 16 * 0.01 per point.
+  EXPECT_LT(error / points.size(), 0.16);
+}
+
+TEST(ProductQuantizerTest, AsymmetricDistancesMatchTableSums) {
+  // 24 slices exercise the 16-, 8- and single-lane paths of the scan.
+  auto points = clustered_points<48>(400, 2);
+  ProductQuantizer<float, 48> pq(24);
+  pq.train(points, 3);
+  auto codes = pq.encode(std::span<const Point<float, 48>>(points));
+
+  auto table = pq.distance_table(points[3]);
+  ASSERT_EQ(table.size(), 24u * 256);
+  std::vector<float> distances(points.size());
+  pq.asymmetric_distances(table, codes, distances);
+  for (size_t i = 0; i < points.size(); ++i) {
+    float expected = 0;
+    for (size_t s = 0; s < 24; ++s)
+      expected += table[s * 256 + codes[i * 24 + s]];
+    EXPECT_NEAR(distances[i], expected, 1e-4f * (1 + expected));
+  }
+
+  // The distance to the decoded point is what the table approximates.
+  auto decoded =
+      pq.decode(std::span<const std::uint8_t>(codes.data() + 5 * 24, 24));
+  EXPECT_NEAR(distances[5], points[3].squared_distance(decoded),
+              1e-3f * (1 + distances[5]));
+}
+
+TEST(ProductQuantizerTest, RejectsInvalidUse) {
+  using Quantizer = ProductQuantizer<float, 16>;
+  EXPECT_THROW(Quantizer(0), std::invalid_argument);
+  EXPECT_THROW(Quantizer(5), std::invalid_argument);
+
+  Quantizer pq(4);
+  auto few = clustered_points<16>(100, 3);
+  EXPECT_THROW(pq.train(few), std::invalid_argument);
+  EXPECT_THROW(pq.distance_table(few[0]), std::runtime_error);
+
+  pq.train(clustered_points<16>(300, 4), 2);
+  std::vector<std::uint8_t> code(3);
+  EXPECT_THROW(pq.encode(few[0], code), std::invalid_argument);
+}
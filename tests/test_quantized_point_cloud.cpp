@@ -0,0 +1,78 @@
+#include "../Core/QuantizedPointCloud.hpp"
+#include <gtest/gtest.h>
+
+using namespace GeomCPP;
+
+using Point3D = Point<double, 3>;
+
+static std::vector<Point3D> make_survey(size_t count) {
+  std::vector<Point3D> points;
+  for (size_t i = 0; i < count; ++i)
+    points.push_back(Point3D({5000.0 + 30.0 * std::sin(0.01 * i),
+                              -2000.0 + 0.05 * static_cast<double>(i),
+                              120.0 + std::cos(0.3 * i)}));
+  return points;
+}
+
+TEST(QuantizedPointCloudTest, DecodeStaysWithinErrorBound) {
+  auto points = make_survey(3000);
+  QuantizedPointCloud<double, 3> cloud(points);
+
+  ASSERT_EQ(cloud.size(), points.size());
+  EXPECT_GT(cloud.error_bound(), 0.0);
+  EXPECT_LT(cloud.error_bound(), 1e-2);
+
+  auto decoded = cloud.decode();
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_LE(cloud[i].distance(points[i]), cloud.error_bound());
+    EXPECT_EQ(decoded[i].get_coordinates(), cloud[i].get_coordinates());
+  }
+}
+
+TEST(QuantizedPointCloudTest, StorageIsSmallerThanPoints) {
+  auto points = make_survey(4096);
+  QuantizedPointCloud<double, 3> cloud(points);
+  EXPECT_LT(cloud.storage_bytes() * 4, points.size() * sizeof(Point3D));
+}
+
+TEST(QuantizedPointCloudTest, KernelsRespectErrorBound) {
+  auto points = make_survey(2500);
+  QuantizedPointCloud<double, 3, std::int32_t> cloud(points);
+  Point3D query({5010.0, -1990.0, 100.0});
+
+  std::vector<double> dists(points.size()), dots(points.size());
+  cloud.distance(query, dists);
+  cloud.dot(query, dots);
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_NEAR(dists[i], points[i].distance(query), cloud.error_bound());
+    EXPECT_NEAR(dots[i], points[i].dot(query),
+                cloud.error_bound() * query.magnitude());
+  }
+}
+
+TEST(QuantizedPointCloudTest, FloatWithInt32Codes) {
+  using Point2F = Point<float, 2>;
+  QuantizedPointCloud<float, 2, std::int32_t> pair(
+      std::vector<Point2F>{Point2F({0.0f, 0.0f}), Point2F({10.0f, 10.0f})});
+  EXPECT_LE(pair[1].distance(Point2F({10.0f, 10.0f})), pair.error_bound());
+  EXPECT_LE(pair[0].distance(Point2F({0.0f, 0.0f})), pair.error_bound());
+
+  // The quantization step is far below float's ulp here, so the bound is
+  // dominated by decode rounding.
+  std::vector<Point2F> points;
+  for (int i = 0; i < 2000; ++i)
+    points.push_back(Point2F({5000.0f + 30.0f * std::sin(0.01f * i),
+                              -2000.0f + 0.05f * static_cast<float>(i)}));
+  QuantizedPointCloud<float, 2, std::int32_t> cloud(points);
+  EXPECT_LT(cloud.error_bound(), 1e-2f);
+  for (size_t i = 0; i < points.size(); ++i)
+    EXPECT_LE(cloud[i].distance(points[i]), cloud.error_bound()) << i;
+}
+
+TEST(QuantizedPointCloudTest, RejectsShortOutput) {
+  QuantizedPointCloud<double, 3> cloud(make_survey(10));
+  std::vector<double> out(9);
+  EXPECT_THROW(cloud.distance(Point3D({0.0, 0.0, 0.0}), out),
+               std::invalid_argument);
+}
@@ -0,0 +1,134 @@
+#include "../Core/RTree.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+using Segment = Line<double, 2>;
+using Box = BoundingBox<double, 2>;
+
+std::vector<Segment> random_segments(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(0.0, 100.0), step(-3.0, 3.0);
+  std::vector<Segment> segments;
+  for (size_t i = 0; i < count; ++i) {
+    double x = coord(rng), y = coord(rng);
+    segments.emplace_back(Point<double, 2>({x, y}),
+                          Point<double, 2>({x + step(rng), y + step(rng)}));
+  }
+  return segments;
+}
+
+std::vector<size_t> sorted(std::vector<size_t> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+// Brute-force checks of every query against the live segments.
+void expect_matches_scan(const RTree<double> &tree,
+                         const std::vector<Segment> &segments,
+                         const std::vector<bool> &live, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(0.0, 100.0);
+  for (int q = 0; q < 20; ++q) {
+    Point<double, 2> c1({coord(rng), coord(rng)});
+    Point<double, 2> c2({c1[0] + 8.0, c1[1] + 5.0});
+    Box area = Box::of(c1, c2);
+    Segment query(c1, c2);
+
+    std::vector<size_t> in_window, candidates, crossing;
+    double best = 1e300;
+    for (size_t i = 0; i < segments.size(); ++i) {
+      if (!live[i])
+        continue;
+      if (area.intersects(segments[i]))
+        in_window.push_back(i);
+      if (Box::of(segments[i]).overlaps(area))
+        candidates.push_back(i);
+      if (query.intersects(segments[i]))
+        crossing.push_back(i);
+      best = std::min(best, detail::segment_squared_distance<double>(
+                                c1, segments[i]));
+    }
+    EXPECT_EQ(sorted(tree.window(c1, c2)), in_window);
+    EXPECT_EQ(sorted(tree.intersection_candidates(query)), candidates);
+    EXPECT_EQ(sorted(tree.intersecting(query)), crossing);
+
+    auto nearest = tree.nearest(c1, 3);
+    ASSERT_FALSE(nearest.empty());
+    EXPECT_DOUBLE_EQ(nearest[0].squared_distance, best);
+    for (size_t i = 1; i < nearest.size(); ++i)
+      EXPECT_LE(nearest[i - 1].squared_distance, nearest[i].squared_distance);
+  }
+}
+} // namespace
+
+TEST(RTreeTest, WindowIntersectionIsExact) {
+  Box area =
+      Box::of(Point<double, 2>({0.0, 0.0}), Point<double, 2>({1.0, 1.0}));
+  // Crosses the corner region without touching the box.
+  EXPECT_FALSE(area.intersects(
+      Segment(Point<double, 2>({1.5, 0.0}), Point<double, 2>({3.0, 1.5}))));
+  // Touches exactly at the corner.
+  EXPECT_TRUE(area.intersects(
+      Segment(Point<double, 2>({1.0, 1.0}), Point<double, 2>({2.0, 3.0}))));
+  EXPECT_TRUE(area.intersects(
+      Segment(Point<double, 2>({-1.0, 0.5}), Point<double, 2>({2.0, 0.5}))));
+}
+
+TEST(RTreeTest, BulkLoadedQueriesMatchScan) {
+  auto segments = random_segments(5000, 1);
+  RTree<double> tree(segments);
+  EXPECT_EQ(tree.size(), segments.size());
+  expect_matches_scan(tree, segments, std::vector<bool>(segments.size(), true),
+                      2);
+}
+
+TEST(RTreeTest, IncrementalInsertAndEraseMatchScan) {
+  auto segments = random_segments(3000, 3);
+  RTree<double> tree;
+  for (size_t i = 0; i < segments.size(); ++i)
+    EXPECT_EQ(tree.insert(segments[i]), i);
+  std::vector<bool> live(segments.size(), true);
+  expect_matches_scan(tree, segments, live, 4);
+
+  std::mt19937 rng(5);
+  for (size_t i = 0; i < segments.size(); ++i) {
+    if (rng() % 3 != 0) {
+      EXPECT_TRUE(tree.erase(i));
+      live[i] = false;
+    }
+  }
+  EXPECT_FALSE(tree.erase(segments.size()));
+  EXPECT_EQ(tree.size(),
+            static_cast<size_t>(std::count(live.begin(), live.end(), true)));
+  expect_matches_scan(tree, segments, live, 6);
+}
+
+TEST(RTreeTest, MixesBulkLoadInsertAndErase) {
+  auto segments = random_segments(800, 7);
+  RTree<double> tree(segments);
+  std::vector<bool> live(segments.size(), true);
+  for (size_t i = 0; i < 600; ++i) {
+    EXPECT_TRUE(tree.erase(i));
+    EXPECT_FALSE(tree.erase(i));
+    live[i] = false;
+  }
+  for (const auto &segment : random_segments(400, 8)) {
+    segments.push_back(segment);
+    live.push_back(true);
+    tree.insert(segment);
+  }
+  expect_matches_scan(tree, segments, live, 9);
+
+  for (size_t i = 0; i < segments.size(); ++i)
+    tree.erase(i);
+  EXPECT_TRUE(tree.empty());
+  EXPECT_TRUE(tree.nearest(Point<double, 2>({0.0, 0.0})).empty());
+  EXPECT_TRUE(tree.window(Point<double, 2>({0.0, 0.0}),
+                          Point<double, 2>({100.0, 100.0}))
+                  .empty());
+}
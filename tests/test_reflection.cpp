@@ -0,0 +1,84 @@
+#include "../Core/Reflection.hpp"
+#include <gtest/gtest.h>
+
+using namespace GeomCPP;
+
+using Point2D = Point<double, 2>;
+using Point3D = Point<double, 3>;
+
+TEST(ReflectionTest, MatchesPointReflect2D) {
+  Point2D a({1.0, -2.0}), b({4.0, 3.5});
+  Reflection<double, 2> mirror(a, b);
+
+  for (int i = 0; i < 50; ++i) {
+    Point2D p({i * 0.37 - 4.0, std::sin(i * 1.0) * 10.0});
+    Point2D expected = p.reflect(a, b);
+    Point2D actual = mirror(p);
+    EXPECT_NEAR(actual[0], expected[0], 1e-12);
+    EXPECT_NEAR(actual[1], expected[1], 1e-12);
+  }
+}
+
+TEST(ReflectionTest, MatchesPointReflect3D) {
+  Point3D origin({1.0, 2.0, 3.0}), normal({0.3, -1.0, 2.0});
+  Reflection<double, 3> mirror(origin, normal);
+
+  Point3D p({5.0, -1.0, 0.5});
+  Point3D expected = p.reflect(origin, normal);
+  Point3D actual = mirror.apply(p);
+  for (size_t d = 0; d < 3; ++d)
+    EXPECT_NEAR(actual[d], expected[d], 1e-12);
+}
+
+TEST(ReflectionTest, RejectsDegenerateHyperplane) {
+  Point2D p({1.0, 1.0});
+  EXPECT_THROW((Reflection<double, 2>(p, p)), std::invalid_argument);
+  Point3D zero({0.0, 0.0, 0.0});
+  EXPECT_THROW((Reflection<double, 3>(zero, zero)), std::invalid_argument);
+}
+
+TEST(ReflectionTest, BatchedSpanAndCloudAgree) {
+  Reflection<double, 3> mirror(Point3D({0.0, 0.0, 1.0}),
+                               Point3D({1.0, 1.0, 1.0}));
+  std::vector<Point3D> points;
+  for (int i = 0; i < 40000; ++i)
+    points.push_back(Point3D({i * 0.001, -i * 0.002, std::cos(i * 0.1)}));
+
+  PointCloud<double, 3> cloud(points);
+  std::vector<Point3D> expected;
+  for (const auto &p : points)
+    expected.push_back(mirror(p));
+
+  mirror.apply(std::span<Point3D>(points), 4);
+  mirror.apply(cloud, 0);
+
+  for (size_t i = 0; i < points.size(); i += 97) {
+    for (size_t d = 0; d < 3; ++d) {
+      EXPECT_NEAR(points[i][d], expected[i][d], 1e-12);
+      EXPECT_NEAR(cloud[i][d], expected[i][d], 1e-12);
+    }
+  }
+}
+
+TEST(ReflectionTest, BatchedFloatMatchesSingle) {
+  using Point2F = Point<float, 2>;
+  Reflection<float, 2> mirror(Point2F({0.5f, -1.0f}), Point2F({2.0f, 3.0f}));
+  std::vector<Point2F> points;
+  for (int i = 0; i < 1001; ++i)
+    points.push_back(Point2F({i * 0.01f, std::sin(i * 0.5f)}));
+
+  PointCloud<float, 2> cloud(points);
+  std::vector<Point2F> expected;
+  for (const auto &p : points)
+    expected.push_back(mirror(p));
+
+  mirror.apply(std::span<Point2F>(points), 2);
+  mirror.apply(cloud);
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    for (size_t d = 0; d < 2; ++d) {
+      EXPECT_NEAR(points[i][d], expected[i][d], 1e-5f);
+      EXPECT_NEAR(cloud[i][d], expected[i][d], 1e-5f);
+    }
+  }
+}
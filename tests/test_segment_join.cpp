@@ -0,0 +1,72 @@
+#include "../Core/SegmentJoin.hpp"
+#include "segment_pairs.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace GeomCPP;
+
+using test_support::brute_force_pairs;
+using test_support::lattice_segments;
+
+TEST(SegmentJoinTest, MatchesBruteForceForAnyTiling) {
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> coord(0.0, 100.0);
+  std::uniform_real_distribution<double> offset(-5.0, 5.0);
+  std::vector<Line<double, 2>> lines;
+  for (int i = 0; i < 800; ++i) {
+    Point<double, 2> a({coord(rng), coord(rng)});
+    // Every tenth segment is long enough to cross many tiles.
+    Point<double, 2> b = i % 10 == 0
+                             ? Point<double, 2>({coord(rng), coord(rng)})
+                             : Point<double, 2>({a[0] + offset(rng),
+                                                 a[1] + offset(rng)});
+    lines.emplace_back(a, b);
+  }
+  std::span<const Line<double, 2>> view(lines);
+  auto expected = brute_force_pairs(lines);
+  ASSERT_GT(expected.size(), 500u);
+
+  for (size_t tiles : {0, 3, 16, 40}) {
+    EXPECT_EQ(intersecting_pairs(view, 4, tiles), expected)
+        << tiles << " tiles";
+    EXPECT_EQ(count_intersecting_pairs(view, 4, tiles), expected.size())
+        << tiles << " tiles";
+  }
+  EXPECT_EQ(intersecting_pairs(view, 1, 8), expected);
+}
+
+TEST(SegmentJoinTest, SharedEndpointsOnTileBordersAreReportedOnce) {
+  // A lattice whose points fall on the borders of a 4 x 4 tiling.
+  auto lines = lattice_segments<int>(300, 8, 6);
+  std::span<const Line<int, 2>> view(lines);
+  auto expected = brute_force_pairs(lines);
+  EXPECT_EQ(intersecting_pairs(view, 4, 4), expected);
+  EXPECT_EQ(count_intersecting_pairs(view, 3, 4), expected.size());
+
+  // All segments vertical on one line: zero width in x.
+  std::vector<Line<int, 2>> vertical{
+      Line<int, 2>(Point<int, 2>({1, 0}), Point<int, 2>({1, 5})),
+      Line<int, 2>(Point<int, 2>({1, 3}), Point<int, 2>({1, 9}))};
+  EXPECT_TRUE(
+      intersecting_pairs(std::span<const Line<int, 2>>(vertical), 2, 4)
+          .empty());
+
+  std::span<const Line<int, 2>> empty;
+  EXPECT_TRUE(intersecting_pairs(empty).empty());
+  EXPECT_EQ(count_intersecting_pairs(empty), 0u);
+}
+
+TEST(SegmentJoinTest, InexactLatticeMatchesBruteForce) {
+  // Near-degenerate crossings whose rounded points order differently from
+  // the exact ones, in every tile.
+  for (unsigned seed = 0; seed < 4; ++seed) {
+    auto lines = lattice_segments<double>(200, 10, 200 + seed, 0.1, 0.3);
+    std::span<const Line<double, 2>> view(lines);
+    auto expected = brute_force_pairs(lines);
+    EXPECT_EQ(intersecting_pairs(view, 4, 3), expected) << "seed " << seed;
+    EXPECT_EQ(count_intersecting_pairs(view, 4, 1), expected.size())
+        << "seed " << seed;
+  }
+}
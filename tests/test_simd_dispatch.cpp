@@ -0,0 +1,73 @@
+#include "../Core/Point.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+std::vector<simd_level> supported_levels() {
+  std::vector<simd_level> levels;
+  for (auto level : {simd_level::scalar, simd_level::sse2, simd_level::avx2,
+                     simd_level::avx512})
+    if (level <= detect_simd_level())
+      levels.push_back(level);
+  return levels;
+}
+
+template <typename T> std::vector<T> make_values(size_t count, T seed) {
+  std::vector<T> values(count);
+  for (size_t i = 0; i < count; ++i)
+    values[i] = static_cast<T>(std::sin(seed * (i + 1)));
+  return values;
+}
+} // namespace
+
+TEST(SimdDispatchTest, ActiveTableMatchesDetectedLevel) {
+  EXPECT_EQ(active_simd_kernels().level,
+            simd_kernels_for(detect_simd_level()).level);
+}
+
+TEST(SimdDispatchTest, KernelsMatchScalarForEveryLength) {
+  for (auto level : supported_levels()) {
+    auto kernels = simd_kernels_for(level);
+    for (size_t count = 0; count <= 70; ++count) {
+      auto lhs_f = make_values<float>(count, 0.7f);
+      auto rhs_f = make_values<float>(count, 1.3f);
+      auto lhs_d = make_values<double>(count, 0.7);
+      auto rhs_d = make_values<double>(count, 1.3);
+
+      EXPECT_NEAR(kernels.dot_f32(lhs_f.data(), rhs_f.data(), count),
+                  detail::scalar_dot(lhs_f.data(), rhs_f.data(), count), 1e-4);
+      EXPECT_NEAR(
+          kernels.squared_distance_f32(lhs_f.data(), rhs_f.data(), count),
+          detail::scalar_squared_distance(lhs_f.data(), rhs_f.data(), count),
+          1e-4);
+      EXPECT_NEAR(kernels.dot_f64(lhs_d.data(), rhs_d.data(), count),
+                  detail::scalar_dot(lhs_d.data(), rhs_d.data(), count),
+                  1e-12);
+      EXPECT_NEAR(
+          kernels.squared_distance_f64(lhs_d.data(), rhs_d.data(), count),
+          detail::scalar_squared_distance(lhs_d.data(), rhs_d.data(), count),
+          1e-12);
+    }
+  }
+}
+
+TEST(SimdDispatchTest, HighDimensionalPointUsesKernels) {
+  std::array<float, 128> lhs_coords, rhs_coords;
+  double dot = 0, squared = 0;
+  for (size_t i = 0; i < 128; ++i) {
+    lhs_coords[i] = static_cast<float>(i % 5) * 0.5f;
+    rhs_coords[i] = static_cast<float>(i % 3) - 1.0f;
+    dot += lhs_coords[i] * rhs_coords[i];
+    double diff = lhs_coords[i] - rhs_coords[i];
+    squared += diff * diff;
+  }
+  Point<float, 128> lhs(lhs_coords), rhs(rhs_coords);
+
+  EXPECT_FLOAT_EQ(lhs.dot(rhs), static_cast<float>(dot));
+  EXPECT_FLOAT_EQ(lhs.squared_distance(rhs), static_cast<float>(squared));
+  EXPECT_FLOAT_EQ(lhs.distance(rhs), static_cast<float>(std::sqrt(squared)));
+  EXPECT_FLOAT_EQ(lhs.magnitude(),
+                  static_cast<float>(std::sqrt(lhs.dot(lhs))));
+}
@@ -0,0 +1,134 @@
+#include "../Core/SpaceFillingCurve.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace GeomCPP;
+
+TEST(SpaceFillingCurveTest, MortonInterleavesAxes) {
+  static_assert(morton_encode(1u, 0u) == 1);
+  static_assert(morton_encode(0u, 1u) == 2);
+  static_assert(morton_encode(3u, 3u) == 15);
+  static_assert(morton_encode(0xFFFFFFFFu, 0u) == 0x5555555555555555ull);
+  static_assert(morton_encode(1u, 0u, 0u) == 1);
+  static_assert(morton_encode(0u, 1u, 0u) == 2);
+  static_assert(morton_encode(0u, 0u, 1u) == 4);
+  static_assert(morton_encode(0x1FFFFFu, 0x1FFFFFu, 0x1FFFFFu) ==
+                0x7FFFFFFFFFFFFFFFull);
+}
+
+#if GEOMCPP_SIMD_X86
+TEST(SpaceFillingCurveTest, PdepMatchesPortableInterleave) {
+  if (!detail::host_supports_bmi2())
+    GTEST_SKIP() << "BMI2 not available";
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<std::uint32_t> wide, narrow(0, 0x1FFFFF);
+  for (int i = 0; i < 1000; ++i) {
+    std::array<std::uint32_t, 2> cell2{wide(rng), wide(rng)};
+    std::array<std::uint32_t, 3> cell3{narrow(rng), narrow(rng), narrow(rng)};
+    EXPECT_EQ(detail::interleave_pdep<2>(cell2), detail::interleave<2>(cell2));
+    EXPECT_EQ(detail::interleave_pdep<3>(cell3), detail::interleave<3>(cell3));
+  }
+}
+#endif
+
+// Walking the cells in Hilbert order must visit every cell once, stepping to
+// a face neighbour each time.
+template <size_t Dim> void expect_hilbert_walk(unsigned bits) {
+  const std::uint32_t side = 1u << bits;
+  size_t cells = 1;
+  for (size_t d = 0; d < Dim; ++d)
+    cells *= side;
+
+  std::vector<std::array<std::uint32_t, Dim>> by_key(cells);
+  std::vector<bool> seen(cells, false);
+  for (size_t index = 0; index < cells; ++index) {
+    std::array<std::uint32_t, Dim> cell;
+    size_t rest = index;
+    for (size_t d = 0; d < Dim; ++d) {
+      cell[d] = static_cast<std::uint32_t>(rest % side);
+      rest /= side;
+    }
+    curve_key key = hilbert_encode<Dim>(cell, bits);
+    ASSERT_LT(key, cells);
+    ASSERT_FALSE(seen[key]);
+    seen[key] = true;
+    by_key[key] = cell;
+  }
+
+  for (size_t key = 1; key < cells; ++key) {
+    int steps = 0;
+    for (size_t d = 0; d < Dim; ++d)
+      steps += std::abs(static_cast<int>(by_key[key][d]) -
+                        static_cast<int>(by_key[key - 1][d]));
+    EXPECT_EQ(steps, 1) << "between keys " << key - 1 << " and " << key;
+  }
+}
+
+TEST(SpaceFillingCurveTest, HilbertVisitsNeighbouringCells) {
+  expect_hilbert_walk<2>(4);
+  expect_hilbert_walk<2>(1);
+  expect_hilbert_walk<3>(3);
+}
+
+TEST(SpaceFillingCurveTest, KeysQuantizeAgainstBoundingBox) {
+  std::vector<Point<double, 2>> points = {Point<double, 2>({-1.0, -1.0}),
+                                          Point<double, 2>({1.0, 1.0}),
+                                          Point<double, 2>({1.0, -1.0})};
+  auto keys = curve_keys(points);
+  EXPECT_EQ(keys[0], 0u);
+  EXPECT_EQ(keys[1], ~curve_key{0});
+  EXPECT_EQ(keys[2], morton_encode(0xFFFFFFFFu, 0u));
+
+  // A degenerate axis quantizes to cell 0.
+  PointCloud<float, 3> flat;
+  flat.push_back(Point<float, 3>({0.0f, 2.0f, 5.0f}));
+  flat.push_back(Point<float, 3>({1.0f, 2.0f, 5.0f}));
+  auto flat_keys = curve_keys(flat, curve::hilbert);
+  EXPECT_EQ(flat_keys[0], 0u);
+  EXPECT_NE(flat_keys[1], 0u);
+}
+
+TEST(SpaceFillingCurveTest, SpatialSortOrdersByKey) {
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<double> coord(-50.0, 50.0);
+  std::vector<Point<double, 3>> points;
+  for (int i = 0; i < 20000; ++i)
+    points.push_back(Point<double, 3>({coord(rng), coord(rng), coord(rng)}));
+  PointCloud<double, 3> cloud(points);
+
+  for (curve kind : {curve::morton, curve::hilbert}) {
+    auto sorted = points;
+    spatial_sort(sorted, kind, 4);
+    auto keys = curve_keys(sorted, kind);
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+    auto sorted_cloud = cloud;
+    spatial_sort(sorted_cloud, kind, 4);
+    auto cloud_keys = curve_keys(sorted_cloud, kind, 2);
+    EXPECT_EQ(cloud_keys, keys);
+
+    auto by_x = [](const Point<double, 3> &a, const Point<double, 3> &b) {
+      return a[0] < b[0];
+    };
+    std::sort(sorted.begin(), sorted.end(), by_x);
+    auto expected = points;
+    std::sort(expected.begin(), expected.end(), by_x);
+    EXPECT_EQ(sorted, expected);
+  }
+}
+
+TEST(SpaceFillingCurveTest, ParallelSortMatchesStdSort) {
+  std::mt19937_64 rng(13);
+  for (size_t count : {size_t{0}, size_t{10}, size_t{50000}, size_t{123457}}) {
+    std::vector<std::uint64_t> values(count);
+    for (auto &value : values)
+      value = rng() % 1000;
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    parallel_sort(values.begin(), values.end(), std::less<>{}, 7);
+    EXPECT_EQ(values, expected);
+  }
+}
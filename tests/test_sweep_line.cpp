@@ -0,0 +1,122 @@
+#include "../Core/SweepLine.hpp"
+#include "segment_pairs.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace GeomCPP;
+
+using test_support::brute_force_pairs;
+using test_support::lattice_segments;
+
+namespace {
+template <typename T>
+std::vector<std::pair<size_t, size_t>> sweep_pairs(SweepLine<T> &sweep) {
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (const auto &hit : sweep.intersections()) {
+    EXPECT_LT(hit.first, hit.second);
+    pairs.emplace_back(hit.first, hit.second);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+} // namespace
+
+TEST(SweepLineTest, RandomSegmentsMatchBruteForce) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> coord(0.0, 100.0);
+  std::uniform_real_distribution<double> offset(-10.0, 10.0);
+  std::vector<Line<double, 2>> lines;
+  for (int i = 0; i < 500; ++i) {
+    Point<double, 2> a({coord(rng), coord(rng)});
+    Point<double, 2> b({a[0] + offset(rng), a[1] + offset(rng)});
+    lines.emplace_back(a, b);
+  }
+
+  SweepLine<double> sweep(lines);
+  auto expected = brute_force_pairs(lines);
+  ASSERT_GT(expected.size(), 100u);
+  EXPECT_EQ(sweep_pairs(sweep), expected);
+  EXPECT_EQ(sweep.count(), expected.size());
+
+  for (const auto &hit : sweep.intersections()) {
+    // The reported point lies on both segments.
+    for (size_t s : {hit.first, hit.second}) {
+      auto start = lines[s].get_start(), end = lines[s].get_end();
+      double cross = (end[0] - start[0]) * (hit.point[1] - start[1]) -
+                     (end[1] - start[1]) * (hit.point[0] - start[0]);
+      EXPECT_NEAR(cross, 0.0, 1e-9);
+    }
+  }
+}
+
+TEST(SweepLineTest, DegenerateLatticeMatchesBruteForce) {
+  for (unsigned seed = 0; seed < 20; ++seed) {
+    auto lines = lattice_segments<int>(60, 6, seed);
+    SweepLine<int> sweep(lines);
+    auto expected = brute_force_pairs(lines);
+    EXPECT_EQ(sweep_pairs(sweep), expected) << "seed " << seed;
+    EXPECT_EQ(sweep.count(), expected.size()) << "seed " << seed;
+  }
+  for (unsigned seed = 0; seed < 5; ++seed) {
+    auto lines = lattice_segments<double>(200, 10, 100 + seed);
+    SweepLine<double> sweep(lines);
+    EXPECT_EQ(sweep_pairs(sweep), brute_force_pairs(lines))
+        << "seed " << seed;
+  }
+}
+
+TEST(SweepLineTest, HandlesCommonPointsAndParallelSegments) {
+  using L = Line<int, 2>;
+  std::vector<L> lines{
+      // Four segments through (2, 2), two of them ending there.
+      L(Point<int, 2>({0, 0}), Point<int, 2>({4, 4})),
+      L(Point<int, 2>({0, 4}), Point<int, 2>({4, 0})),
+      L(Point<int, 2>({2, 0}), Point<int, 2>({2, 2})),
+      L(Point<int, 2>({0, 2}), Point<int, 2>({2, 2})),
+      // Collinear with the first and overlapping it: only that pair is
+      // not reported.
+      L(Point<int, 2>({1, 1}), Point<int, 2>({3, 3})),
+      // Parallel and disjoint from everything.
+      L(Point<int, 2>({5, 0}), Point<int, 2>({5, 4})),
+  };
+  SweepLine<int> sweep(lines);
+  auto hits = sweep.intersections();
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (const auto &hit : hits) {
+    pairs.emplace_back(hit.first, hit.second);
+    EXPECT_DOUBLE_EQ(hit.point[0], 2.0);
+    EXPECT_DOUBLE_EQ(hit.point[1], 2.0);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(pairs, brute_force_pairs(lines));
+  EXPECT_EQ(pairs.size(), 9u); // all pairs of the five but the collinear one
+
+  std::vector<L> none;
+  SweepLine<int> empty(none);
+  EXPECT_EQ(empty.count(), 0u);
+  EXPECT_TRUE(empty.intersections().empty());
+}
+
+TEST(SweepLineTest, InexactLatticeMatchesBruteForce) {
+  // Lattice products that double rounds: the rounded crossing points of
+  // these segments order differently from the exact ones.
+  using P = Point<double, 2>;
+  std::vector<Line<double, 2>> lines{
+      Line<double, 2>(P({1 * 0.1, 8 * 0.3}), P({5 * 0.1, 4 * 0.3})),
+      Line<double, 2>(P({3 * 0.1, 2 * 0.3}), P({3 * 0.1, 6 * 0.3})),
+      Line<double, 2>(P({4 * 0.1, 8 * 0.3}), P({0.0, 0.0}))};
+  SweepLine<double> small(lines);
+  EXPECT_EQ(small.count(), 2u);
+  EXPECT_EQ(sweep_pairs(small), brute_force_pairs(lines));
+
+  for (unsigned seed = 0; seed < 12; ++seed) {
+    auto lattice = lattice_segments<double>(150, 10, seed, 0.1, 0.3);
+    SweepLine<double> sweep(lattice);
+    auto expected = brute_force_pairs(lattice);
+    EXPECT_EQ(sweep_pairs(sweep), expected) << "seed " << seed;
+    EXPECT_EQ(sweep.count(), expected.size()) << "seed " << seed;
+  }
+}
@@ -0,0 +1,147 @@
+#include "../Core/Transform.hpp"
+#include <gtest/gtest.h>
+#include <numbers>
+
+using namespace GeomCPP;
+
+using Point2D = Point<double, 2>;
+using Point3D = Point<double, 3>;
+using Transform2D = Transform<double, 2>;
+using Transform3D = Transform<double, 3>;
+
+template <size_t Dim>
+static void expect_near(const Point<double, Dim> &actual,
+                        const Point<double, Dim> &expected) {
+  for (size_t d = 0; d < Dim; ++d)
+    EXPECT_NEAR(actual[d], expected[d], 1e-12);
+}
+
+TEST(TransformTest, Presets) {
+  Point2D p({1.0, 2.0});
+  expect_near(Transform2D::translation(Point2D({3.0, -1.0}))(p),
+              Point2D({4.0, 1.0}));
+  expect_near(Transform2D::scaling(2.0)(p), Point2D({2.0, 4.0}));
+  expect_near(Transform2D::scaling(Point2D({-1.0, 3.0}))(p),
+              Point2D({-1.0, 6.0}));
+  expect_near(Transform2D::rotation(std::numbers::pi / 2)(p),
+              Point2D({-2.0, 1.0}));
+
+  Point3D q({1.0, 0.0, 0.0});
+  expect_near(Transform3D::rotation(Point3D({0.0, 0.0, 2.0}),
+                                    std::numbers::pi / 2)(q),
+              Point3D({0.0, 1.0, 0.0}));
+  EXPECT_THROW(Transform3D::rotation(Point3D({0.0, 0.0, 0.0}), 1.0),
+               std::invalid_argument);
+}
+
+TEST(TransformTest, IntegerAxisRotationIsOrthonormal) {
+  // A non-unit integer axis is normalised in the real type, not in T.
+  auto rotate = Transform<int, 3>::rotation(Point<int, 3>({1, 2, 3}), 0.9);
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j) {
+      double dot = 0;
+      for (size_t k = 0; k < 3; ++k)
+        dot += rotate(k, i) * rotate(k, j);
+      EXPECT_NEAR(dot, i == j ? 1.0 : 0.0, 1e-12) << i << ", " << j;
+    }
+  auto reference = Transform3D::rotation(Point3D({1.0, 2.0, 3.0}), 0.9);
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      EXPECT_NEAR(rotate(i, j), reference(i, j), 1e-12);
+}
+
+TEST(TransformTest, ReflectionMatchesPointReflect) {
+  Point2D a({0.0, 1.0}), b({2.0, 4.0});
+  Point2D p({3.0, -2.0});
+  expect_near(Transform2D::reflection(a, b)(p), p.reflect(a, b));
+
+  Point3D origin({1.0, 1.0, 1.0}), normal({0.0, 2.0, 1.0});
+  Point3D q({-3.0, 4.0, 0.5});
+  expect_near(Transform3D::reflection(origin, normal)(q),
+              q.reflect(origin, normal));
+}
+
+TEST(TransformTest, CompositionOrderAndInverse) {
+  auto rotate = Transform2D::rotation(0.3);
+  auto shift = Transform2D::translation(Point2D({5.0, -2.0}));
+  Point2D p({1.5, 0.25});
+
+  expect_near((shift * rotate)(p), shift(rotate(p)));
+  expect_near(rotate.then(shift)(p), shift(rotate(p)));
+
+  auto chain = rotate.then(shift).then(Transform2D::scaling(3.0));
+  expect_near(chain.inverse()(chain(p)), p);
+
+  auto identity = chain * chain.inverse();
+  for (size_t r = 0; r < 3; ++r)
+    for (size_t c = 0; c < 3; ++c)
+      EXPECT_NEAR(identity(r, c), r == c ? 1.0 : 0.0, 1e-12);
+
+  EXPECT_THROW(Transform2D::scaling(0.0).inverse(), std::runtime_error);
+}
+
+TEST(TransformTest, ProjectiveDivide) {
+  Transform2D::matrix values = {{{1, 0, 0}, {0, 1, 0}, {0.5, 0, 1}}};
+  Transform2D projection(values);
+  EXPECT_FALSE(projection.is_affine());
+  expect_near(projection(Point2D({2.0, 4.0})), Point2D({1.0, 2.0}));
+  EXPECT_THROW(projection(Point2D({-2.0, 0.0})), std::runtime_error);
+}
+
+TEST(TransformTest, BatchedApplicationMatchesSingle) {
+  auto chain = Transform3D::rotation(Point3D({1.0, 1.0, 0.0}), 0.7)
+                   .then(Transform3D::translation(Point3D({1.0, 2.0, 3.0})))
+                   .then(Transform3D::scaling(0.5));
+
+  std::vector<Point3D> points;
+  for (int i = 0; i < 50000; ++i)
+    points.push_back(Point3D({i * 0.01, std::sin(i * 0.1), -i * 0.002}));
+  PointCloud<double, 3> cloud(points);
+
+  std::vector<Point3D> expected;
+  for (const auto &p : points)
+    expected.push_back(chain(p));
+
+  chain.apply(std::span<Point3D>(points), 3);
+  chain.apply(cloud, 0);
+  for (size_t i = 0; i < points.size(); i += 101) {
+    expect_near(points[i], expected[i]);
+    expect_near(cloud[i], expected[i]);
+  }
+}
+
+TEST(TransformTest, BatchedProjectiveChecksEveryPointFirst) {
+  Transform2D::matrix values = {{{1, 0, 0}, {0, 1, 0}, {0.5, 0, 1}}};
+  Transform2D projection(values);
+
+  std::vector<Point2D> points;
+  for (int i = 0; i < 40000; ++i)
+    points.push_back(Point2D({i * 0.001, 1.0 - i * 0.003}));
+  std::vector<Point2D> expected;
+  for (const auto &p : points)
+    expected.push_back(projection(p));
+
+  PointCloud<double, 2> cloud(points);
+  projection.apply(std::span<Point2D>(points), 2);
+  projection.apply(cloud, 2);
+  for (size_t i = 0; i < points.size(); i += 101) {
+    expect_near(points[i], expected[i]);
+    expect_near(cloud[i], expected[i]);
+  }
+
+  // The last point has w == 0; nothing may be written before the throw.
+  points.push_back(Point2D({-2.0, 0.0}));
+  std::vector<Point2D> before = points;
+  PointCloud<double, 2> degenerate(points);
+  EXPECT_THROW(projection.apply(std::span<Point2D>(points), 4),
+               std::runtime_error);
+  EXPECT_THROW(projection.apply(degenerate, 4), std::runtime_error);
+  for (size_t i = 0; i < points.size(); i += 101) {
+    EXPECT_EQ(points[i], before[i]);
+    EXPECT_EQ(degenerate[i], before[i]);
+  }
+}
+
+static_assert(Transform2D::translation(Point2D({1.0, 2.0}))
+                  .then(Transform2D::scaling(2.0))(Point2D({0.0, 0.0})) ==
+              Point2D({2.0, 4.0}));
@@ -0,0 +1,123 @@
+#include "../Core/UniformGrid.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+using P = Point<double, 2>;
+using Segment = Line<double, 2>;
+using Box = BoundingBox<double, 2>;
+
+std::vector<P> random_points(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(0.0, 50.0);
+  std::vector<P> points;
+  for (size_t i = 0; i < count; ++i)
+    points.push_back(P({coord(rng), coord(rng)}));
+  return points;
+}
+
+std::vector<Segment> random_segments(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(0.0, 50.0), step(-6.0, 6.0);
+  std::vector<Segment> segments;
+  for (size_t i = 0; i < count; ++i) {
+    double x = coord(rng), y = coord(rng);
+    segments.emplace_back(P({x, y}), P({x + step(rng), y + step(rng)}));
+  }
+  return segments;
+}
+} // namespace
+
+TEST(UniformGridTest, PointQueriesMatchScan) {
+  auto points = random_points(4000, 1);
+  UniformGrid<double> grid(points, 2.0, 4);
+  EXPECT_EQ(grid.point_count(), points.size());
+
+  for (const P &center : random_points(25, 2)) {
+    Box area = Box::of(center, P({center[0] + 4.0, center[1] + 1.5}));
+    std::vector<size_t> boxed, near;
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (area.contains(points[i]))
+        boxed.push_back(i);
+      if (points[i].squared_distance(center) <= 9.0)
+        near.push_back(i);
+    }
+    EXPECT_EQ(grid.points_in_box(area), boxed);
+    EXPECT_EQ(grid.points_within_radius(center, 3.0), near);
+  }
+
+  auto pairs = grid.point_pairs_within(0.5, 3);
+  std::vector<std::pair<size_t, size_t>> expected;
+  for (size_t i = 0; i < points.size(); ++i)
+    for (size_t j = i + 1; j < points.size(); ++j)
+      if (points[i].squared_distance(points[j]) <= 0.25)
+        expected.emplace_back(i, j);
+  EXPECT_EQ(pairs, expected);
+}
+
+TEST(UniformGridTest, SegmentQueriesMatchScan) {
+  auto segments = random_segments(1500, 3);
+  UniformGrid<double> grid(segments, 1.5, 4);
+
+  for (const P &center : random_points(25, 4)) {
+    Box area = Box::of(center, P({center[0] + 3.0, center[1] + 2.0}));
+    std::vector<size_t> boxed, near;
+    for (size_t i = 0; i < segments.size(); ++i) {
+      if (area.intersects(segments[i]))
+        boxed.push_back(i);
+      if (detail::segment_squared_distance<double>(center, segments[i]) <=
+          4.0)
+        near.push_back(i);
+    }
+    EXPECT_EQ(grid.segments_in_box(area), boxed);
+    EXPECT_EQ(grid.segments_within_radius(center, 2.0), near);
+  }
+
+  // Every intersecting pair shares a cell.
+  auto candidates = grid.segment_candidate_pairs(4);
+  EXPECT_EQ(candidates, grid.segment_candidate_pairs(1));
+  for (size_t i = 0; i < segments.size(); ++i) {
+    for (size_t j = i + 1; j < segments.size(); ++j) {
+      if (segments[i].intersects(segments[j])) {
+        EXPECT_TRUE(std::binary_search(candidates.begin(), candidates.end(),
+                                       std::make_pair(i, j)))
+            << i << ", " << j;
+      }
+    }
+  }
+}
+
+TEST(UniformGridTest, SegmentsMeetingOnCellBoundariesArePaired) {
+  // Crossings exactly on grid lines and corners (cell size 1, origin 0).
+  std::vector<Segment> segments = {
+      Segment(P({0.0, 0.0}), P({4.0, 4.0})),
+      Segment(P({0.0, 4.0}), P({4.0, 0.0})), // crosses the first at (2, 2)
+      Segment(P({2.0, 0.0}), P({2.0, 1.0})), // vertical on x = 2
+      Segment(P({1.0, 1.0}), P({3.0, 0.0})), // meets the third at (2, 0.5)
+  };
+  UniformGrid<double> grid(segments, 1.0);
+  auto candidates = grid.segment_candidate_pairs();
+  for (auto pair : {std::make_pair(size_t{0}, size_t{1}),
+                    std::make_pair(size_t{2}, size_t{3})})
+    EXPECT_TRUE(
+        std::binary_search(candidates.begin(), candidates.end(), pair));
+}
+
+TEST(UniformGridTest, MixedItemsAndValidation) {
+  std::vector<P> points = {P({0.0, 0.0}), P({10.0, 10.0})};
+  std::vector<Segment> segments = {Segment(P({0.0, 10.0}), P({10.0, 0.0}))};
+  UniformGrid<double> grid(points, segments, 2.5);
+  EXPECT_EQ(grid.get_columns(), 5u);
+  EXPECT_EQ(grid.get_rows(), 5u);
+  EXPECT_EQ(grid.segments_within_radius(P({5.0, 5.0}), 0.1),
+            std::vector<size_t>{0});
+  EXPECT_EQ(grid.points_within_radius(P({9.0, 9.0}), 1.5),
+            std::vector<size_t>{1});
+
+  EXPECT_THROW(UniformGrid<double>(points, 0.0), std::invalid_argument);
+  EXPECT_THROW(UniformGrid<double>(points, 1e-9), std::invalid_argument);
+}
@@ -0,0 +1,180 @@
+#include "../Core/VPTree.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace GeomCPP;
+
+namespace {
+template <size_t Dim>
+std::vector<Point<float, Dim>> random_points(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> coord(0.0f, 1.0f);
+  std::vector<Point<float, Dim>> points;
+  for (size_t i = 0; i < count; ++i) {
+    std::array<float, Dim> coords;
+    for (auto &c : coords)
+      c = coord(rng);
+    points.emplace_back(coords);
+  }
+  return points;
+}
+} // namespace
+
+TEST(VPTreeTest, NearestMatchesBruteForceInHighDimensions) {
+  auto points = random_points<64>(3000, 1);
+  VPTree<float, 64> tree(points, 4);
+  ASSERT_EQ(tree.size(), points.size());
+
+  for (const auto &query : random_points<64>(20, 2)) {
+    std::vector<std::pair<float, size_t>> expected;
+    for (size_t i = 0; i < points.size(); ++i)
+      expected.emplace_back(query.distance(points[i]), i);
+    std::sort(expected.begin(), expected.end());
+
+    auto result = tree.nearest(query, 10);
+    ASSERT_EQ(result.size(), 10u);
+    for (size_t i = 0; i < result.size(); ++i) {
+      EXPECT_EQ(result[i].distance, expected[i].first);
+      EXPECT_EQ(result[i].index, expected[i].second);
+    }
+  }
+}
+
+TEST(VPTreeTest, RadiusMatchesBruteForce) {
+  auto points = random_points<128>(2000, 3);
+  VPTree<float, 128> tree(points);
+
+  for (const auto &query : random_points<128>(10, 4)) {
+    std::vector<float> distances;
+    for (const auto &p : points)
+      distances.push_back(query.distance(p));
+    auto sorted = distances;
+    std::sort(sorted.begin(), sorted.end());
+    float radius = sorted[50]; // about 50 points inside
+
+    std::vector<size_t> found;
+    for (const auto &n : tree.within_radius(query, radius))
+      found.push_back(n.index);
+    std::sort(found.begin(), found.end());
+
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < points.size(); ++i)
+      if (distances[i] <= radius)
+        expected.push_back(i);
+    EXPECT_EQ(found, expected);
+  }
+}
+
+TEST(VPTreeTest, RadiusBoundaryFarFromVantagePoints) {
+  // A tight cluster about 1000 away from the remaining points: vantage
+  // distances carry rounding errors far larger than the gaps that decide
+  // pruning, and radii are set to exact neighbour distances.
+  std::mt19937 rng(6);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  for (int trial = 0; trial < 300; ++trial) {
+    std::vector<Point<float, 2>> points;
+    for (int i = 0; i < 12; ++i)
+      points.emplace_back(std::array<float, 2>{3 * unit(rng), 3 * unit(rng)});
+    auto near_cluster = [&] {
+      return Point<float, 2>(std::array<float, 2>{
+          1000.0f + 2e-3f * unit(rng), 2e-3f * unit(rng)});
+    };
+    for (int i = 0; i < 40; ++i)
+      points.push_back(near_cluster());
+    VPTree<float, 2> tree(points);
+
+    for (int q = 0; q < 30; ++q) {
+      Point<float, 2> query = near_cluster();
+      std::vector<float> distances;
+      for (const auto &p : points)
+        distances.push_back(query.distance(p));
+      auto sorted = distances;
+      std::sort(sorted.begin(), sorted.end());
+      for (size_t rank : {0u, 1u, 3u, 10u}) {
+        size_t expected = std::count_if(
+            distances.begin(), distances.end(),
+            [&](float d) { return d <= sorted[rank]; });
+        ASSERT_EQ(tree.within_radius(query, sorted[rank]).size(), expected);
+      }
+    }
+  }
+}
+
+TEST(VPTreeTest, IntegerCoordinatesMatchBruteForce) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> coord(-50, 50);
+  auto distance = [](const auto &a, const auto &b) {
+    double sum = 0;
+    for (size_t d = 0; d < a.get_dimensions(); ++d)
+      sum += double(a[d] - b[d]) * double(a[d] - b[d]);
+    return std::sqrt(sum);
+  };
+
+  std::vector<Point<int, 2>> flat;
+  for (int i = 0; i < 500; ++i)
+    flat.push_back(Point<int, 2>({coord(rng), coord(rng)}));
+  VPTree<int, 2> flat_tree(flat);
+  static_assert(std::is_same_v<VPTree<int, 2>::real, double>);
+  for (int q = 0; q < 200; ++q) {
+    Point<int, 2> query({coord(rng), coord(rng)});
+    double radius = 0.5 * (q % 40);
+    size_t expected = std::count_if(flat.begin(), flat.end(), [&](auto &p) {
+      return distance(query, p) <= radius;
+    });
+    ASSERT_EQ(flat_tree.within_radius(query, radius).size(), expected) << q;
+  }
+
+  std::vector<Point<int, 4>> points;
+  auto random_point = [&] {
+    return Point<int, 4>({coord(rng), coord(rng), coord(rng), coord(rng)});
+  };
+  for (int i = 0; i < 800; ++i)
+    points.push_back(random_point());
+  VPTree<int, 4> tree(points);
+  for (int q = 0; q < 50; ++q) {
+    Point<int, 4> query = random_point();
+    std::vector<double> expected;
+    for (const auto &p : points)
+      expected.push_back(distance(query, p));
+    std::sort(expected.begin(), expected.end());
+
+    auto result = tree.nearest(query, 5);
+    ASSERT_EQ(result.size(), 5u);
+    for (size_t i = 0; i < result.size(); ++i)
+      EXPECT_DOUBLE_EQ(result[i].distance, expected[i]) << q;
+  }
+}
+
+TEST(VPTreeTest, BatchedQueriesMatchSingleQueries) {
+  auto points = random_points<32>(1500, 5);
+  VPTree<float, 32> tree(points, 0);
+  auto queries = random_points<32>(100, 6);
+
+  auto batched = tree.nearest(std::span<const Point<float, 32>>(queries), 4);
+  auto radius =
+      tree.within_radius(std::span<const Point<float, 32>>(queries), 6.0f, 3);
+  for (size_t q = 0; q < queries.size(); ++q) {
+    auto single = tree.nearest(queries[q], 4);
+    ASSERT_EQ(batched[q].size(), single.size());
+    for (size_t i = 0; i < single.size(); ++i)
+      EXPECT_EQ(batched[q][i].index, single[i].index);
+    EXPECT_EQ(radius[q].size(), tree.within_radius(queries[q], 6.0f).size());
+  }
+}
+
+TEST(VPTreeTest, HandlesSmallAndDuplicateInputs) {
+  VPTree<double, 3> empty_tree;
+  EXPECT_TRUE(empty_tree.nearest(Point<double, 3>({0.0, 0.0, 0.0}), 2).empty());
+
+  std::vector<Point<double, 3>> same(40, Point<double, 3>({1.0, 1.0, 1.0}));
+  same.push_back(Point<double, 3>({5.0, 1.0, 1.0}));
+  VPTree<double, 3> tree(same);
+  auto nearest = tree.nearest(Point<double, 3>({6.0, 1.0, 1.0}), 2);
+  ASSERT_EQ(nearest.size(), 2u);
+  EXPECT_EQ(nearest[0].index, 40u);
+  EXPECT_DOUBLE_EQ(nearest[1].distance, 5.0);
+  EXPECT_EQ(tree.within_radius(Point<double, 3>({1.0, 1.0, 1.0}), 0.0).size(),
+            40u);
+}